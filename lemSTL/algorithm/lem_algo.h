@@ -0,0 +1,1534 @@
+// Algorithms on ranges (sorting, merging, compaction, etc.);
+#ifndef LEMSTL_LEM_ALGO_H_
+#define LEMSTL_LEM_ALGO_H_
+
+#include <cstddef> // for ptrdiff_t;
+#include <cstdint> // for uint32_t;
+#include <utility> // for std::move();
+#include <exception> // for std::exception;
+
+#include "../lem_iterator" // for iterator_traits, distance() and advance();
+#include "../lem_functional" // for less;
+// EM NOTE: lem_memory is not included here,
+// since lem_uninitialized.h includes lem_algorithm, and vice versa.
+#include "../allocator/lem_alloc.h" // for simple_alloc;
+#include "../allocator/lem_construct.h" // for construct() and destroy();
+#include "lem_algobase.h" // for copy(), swap(), swap_ranges() and __bulk_move();
+#include "lem_heap.h" // for make_heap() and sort_heap();
+#include "lem_sort_network.h" // for __sort_network();
+#include "lem_simd.h" // for __simd_dispatch and SIMD settings;
+#include "lem_prefetch.h" // for __list_prefetch_walk();
+
+namespace lem {
+/* sort() (impl. introsort) */
+// EM NOTE: introsort is quicksort with two guards.
+// 1. Partitions no longer than __kSortThreshold are left unsorted,
+//    and a single insertion sort over the whole range finishes them,
+//    since every element is then at most __kSortThreshold away from its place.
+// 2. If the recursion goes deeper than 2 * log2(n),
+//    the partition is heap-sorted instead, which bounds the worst case by O(nlogn).
+// For POD elements, small partitions are sorted right away by a sorting network
+// instead, whose branchless compare-exchanges beat the data-dependent
+// branches of insertion sort on small inputs, e.g. sorting millions of tiny arrays.
+
+constexpr ptrdiff_t __kSortThreshold = 16;
+
+// floor(log2(n)), depth limit of introsort;
+template <typename Size>
+inline Size __lg(Size n) {
+  Size k = 0;
+  for (; n > 1; n >>= 1) {
+    ++k;
+  }
+
+  return k;
+}
+
+/* insertion sort */
+// Insert *last into the sorted range before it.
+// EM NOTE: unguarded, i.e. there must be some element before last
+// that is not greater than *last, otherwise it runs out of range.
+template <typename RandomAccessIterator, typename Comp>
+void __unguarded_linear_insert(RandomAccessIterator last, Comp islt) {
+  typename iterator_traits<RandomAccessIterator>::value_type value = ::std::move(*last);
+  RandomAccessIterator next = last;
+  --next;
+
+  while (islt(value, *next)) {
+    *last = ::std::move(*next);
+    last = next;
+    --next;
+  }
+  *last = ::std::move(value);
+
+  return;
+}
+template <typename RandomAccessIterator, typename Comp>
+void __insertion_sort(RandomAccessIterator head, RandomAccessIterator tail, Comp islt) {
+  if (head == tail) {
+    return;
+  }
+
+  for (RandomAccessIterator cur = head + 1; cur != tail; ++cur) {
+    if (islt(*cur, *head)) { // *cur is the new minimum;
+      typename iterator_traits<RandomAccessIterator>::value_type value = ::std::move(*cur);
+      for (RandomAccessIterator mov = cur; mov != head; --mov) {
+        *mov = ::std::move(*(mov - 1));
+      }
+      *head = ::std::move(value);
+    }
+    else { // *head guards the insertion;
+      ::lem::__unguarded_linear_insert(cur, islt);
+    }
+  }
+
+  return;
+}
+template <typename RandomAccessIterator, typename Comp>
+void __final_insertion_sort(RandomAccessIterator head, RandomAccessIterator tail, Comp islt) {
+  if (tail - head <= __kSortThreshold) {
+    ::lem::__insertion_sort(head, tail, islt);
+
+    return;
+  }
+
+  // The minimum is now among the first __kSortThreshold elements,
+  // so the rest can be inserted without guard.
+  ::lem::__insertion_sort(head, head + __kSortThreshold, islt);
+  for (RandomAccessIterator cur = head + __kSortThreshold; cur != tail; ++cur) {
+    ::lem::__unguarded_linear_insert(cur, islt);
+  }
+
+  return;
+}
+/* end insertion sort */
+
+/* quicksort partition */
+template <typename T, typename Comp>
+inline T const& __median(T const& a, T const& b, T const& c, Comp islt) {
+  if (islt(a, b)) {
+    return islt(b, c) ? b : (islt(a, c) ? c : a);
+  }
+
+  // Now b <= a;
+  return islt(a, c) ? a : (islt(b, c) ? c : b);
+}
+// EM NOTE: pivot is the median of 3 elements in the range,
+// so neither scan will go out of range without any boundary check.
+template <typename RandomAccessIterator, typename T, typename Comp>
+RandomAccessIterator __unguarded_partition(RandomAccessIterator head, RandomAccessIterator tail, T const& pivot, Comp islt) {
+  for (;;) {
+    while (islt(*head, pivot)) {
+      ++head;
+    }
+    --tail;
+    while (islt(pivot, *tail)) {
+      --tail;
+    }
+
+    if (!(head < tail)) {
+      return head;
+    }
+
+    ::lem::swap(*head, *tail);
+    ++head;
+  }
+}
+/* end quicksort partition */
+
+// base case of introsort;
+template <typename RandomAccessIterator, typename Comp>
+inline void __small_sort(RandomAccessIterator head, RandomAccessIterator tail, Comp islt, ::lem::__true_tag) {
+  ::lem::__sort_network<__kSortThreshold>(head, tail, islt);
+}
+// left to __final_insertion_sort();
+template <typename RandomAccessIterator, typename Comp>
+inline void __small_sort(RandomAccessIterator, RandomAccessIterator, Comp, ::lem::__false_tag) {}
+
+template <typename RandomAccessIterator, typename Size, typename Comp>
+void __introsort_loop(RandomAccessIterator head, RandomAccessIterator tail, Size depth_limit, Comp islt) {
+  using value_type = typename iterator_traits<RandomAccessIterator>::value_type;
+  using is_POD = typename __type_traits<value_type>::is_POD_type;
+
+  while (tail - head > __kSortThreshold) {
+    if (depth_limit == 0) { // too deep, quicksort is degenerating;
+      ::lem::make_heap(head, tail, islt);
+      ::lem::sort_heap(head, tail, islt);
+
+      return;
+    }
+    --depth_limit;
+
+    // EM NOTE: pivot must be a copy, since the element it comes from
+    // may be swapped away during partition.
+    value_type pivot = ::lem::__median(*head, *(head + (tail - head) / 2), *(tail - 1), islt);
+    RandomAccessIterator cut = ::lem::__unguarded_partition(head, tail, pivot, islt);
+
+    // recurse on the right part, and loop on the left part;
+    ::lem::__introsort_loop(cut, tail, depth_limit, islt);
+    tail = cut;
+  }
+  ::lem::__small_sort(head, tail, islt, is_POD());
+
+  return;
+}
+
+template <typename RandomAccessIterator, typename Comp>
+inline void __final_sort(RandomAccessIterator, RandomAccessIterator, Comp, ::lem::__true_tag) {}
+template <typename RandomAccessIterator, typename Comp>
+inline void __final_sort(RandomAccessIterator head, RandomAccessIterator tail, Comp islt, ::lem::__false_tag) {
+  ::lem::__final_insertion_sort(head, tail, islt);
+}
+
+// sort() is not stable;
+template <typename RandomAccessIterator, typename Comp>
+inline void sort(RandomAccessIterator head, RandomAccessIterator tail, Comp islt) {
+  using value_type = typename iterator_traits<RandomAccessIterator>::value_type;
+  using is_POD = typename __type_traits<value_type>::is_POD_type;
+
+  if (head == tail) {
+    return;
+  }
+
+  ::lem::__introsort_loop(head, tail, ::lem::__lg(tail - head) * 2, islt);
+  ::lem::__final_sort(head, tail, islt, is_POD());
+
+  return;
+}
+template <typename RandomAccessIterator>
+inline void sort(RandomAccessIterator head, RandomAccessIterator tail) {
+  using value_type = typename iterator_traits<RandomAccessIterator>::value_type;
+  ::lem::sort(head, tail, ::lem::less<value_type>());
+}
+/* end sort() */
+
+/* non-modifying sequence operations */
+// EM NOTE: the overloads for list iterators walk the nodes with software prefetch,
+// see lem_prefetch.h. Segmented iterators are walked one segment at a time,
+// see __for_each_segment() in lem_iterator.h.
+
+/* for_each() */
+template <typename InputIterator, typename UnaryFunction>
+UnaryFunction __for_each(InputIterator head, InputIterator tail, UnaryFunction& f, ::lem::__false_tag) {
+  for (; head != tail; ++head) {
+    f(*head);
+  }
+
+  return f;
+}
+template <typename SegmentedIterator, typename UnaryFunction>
+UnaryFunction __for_each(SegmentedIterator head, SegmentedIterator tail, UnaryFunction& f, ::lem::__true_tag) {
+  using local_iterator = typename __segmented_iterator_traits<SegmentedIterator>::local_iterator;
+
+  auto visit = [&f](local_iterator local_head, local_iterator local_tail) {
+    ::lem::__for_each(local_head, local_tail, f, ::lem::__false_tag());
+  };
+  ::lem::__for_each_segment(head, tail, visit);
+
+  return f;
+}
+template <typename InputIterator, typename UnaryFunction>
+inline UnaryFunction for_each(InputIterator head, InputIterator tail, UnaryFunction f) {
+  return ::lem::__for_each(head, tail, f, __is_segmented_iterator<InputIterator>());
+}
+template <typename DataType, typename PointerType, typename ReferenceType, typename UnaryFunction>
+UnaryFunction for_each(__list_iterator<DataType, PointerType, ReferenceType> head,
+                       __list_iterator<DataType, PointerType, ReferenceType> tail, UnaryFunction f) {
+  auto visit = [&f](ReferenceType data) {
+    f(data);
+    return false;
+  };
+  ::lem::__list_prefetch_walk(head, tail, visit);
+
+  return f;
+}
+/* end for_each() */
+
+/* find_if() */
+template <typename InputIterator, typename UnaryPredicate>
+InputIterator find_if(InputIterator head, InputIterator tail, UnaryPredicate pred) {
+  while (head != tail && !pred(*head)) {
+    ++head;
+  }
+
+  return head;
+}
+template <typename DataType, typename PointerType, typename ReferenceType, typename UnaryPredicate>
+inline __list_iterator<DataType, PointerType, ReferenceType>
+find_if(__list_iterator<DataType, PointerType, ReferenceType> head,
+        __list_iterator<DataType, PointerType, ReferenceType> tail, UnaryPredicate pred) {
+  auto visit = [&pred](ReferenceType data) -> bool {
+    return pred(data);
+  };
+
+  return ::lem::__list_prefetch_walk(head, tail, visit);
+}
+template <typename InputIterator, typename T>
+inline InputIterator find(InputIterator head, InputIterator tail, T const& value) {
+  return ::lem::find_if(head, tail, [&value](typename iterator_traits<InputIterator>::value_type const& data) -> bool {
+    return data == value;
+  });
+}
+/* end find_if() */
+
+/* count_if() */
+template <typename InputIterator, typename UnaryPredicate>
+typename iterator_traits<InputIterator>::difference_type
+__count_if(InputIterator head, InputIterator tail, UnaryPredicate& pred, ::lem::__false_tag) {
+  typename iterator_traits<InputIterator>::difference_type count = 0;
+  for (; head != tail; ++head) {
+    if (pred(*head)) {
+      ++count;
+    }
+  }
+
+  return count;
+}
+template <typename SegmentedIterator, typename UnaryPredicate>
+typename iterator_traits<SegmentedIterator>::difference_type
+__count_if(SegmentedIterator head, SegmentedIterator tail, UnaryPredicate& pred, ::lem::__true_tag) {
+  using local_iterator = typename __segmented_iterator_traits<SegmentedIterator>::local_iterator;
+
+  typename iterator_traits<SegmentedIterator>::difference_type count = 0;
+  auto visit = [&pred, &count](local_iterator local_head, local_iterator local_tail) {
+    count += ::lem::__count_if(local_head, local_tail, pred, ::lem::__false_tag());
+  };
+  ::lem::__for_each_segment(head, tail, visit);
+
+  return count;
+}
+template <typename InputIterator, typename UnaryPredicate>
+inline typename iterator_traits<InputIterator>::difference_type
+count_if(InputIterator head, InputIterator tail, UnaryPredicate pred) {
+  return ::lem::__count_if(head, tail, pred, __is_segmented_iterator<InputIterator>());
+}
+template <typename DataType, typename PointerType, typename ReferenceType, typename UnaryPredicate>
+ptrdiff_t count_if(__list_iterator<DataType, PointerType, ReferenceType> head,
+                   __list_iterator<DataType, PointerType, ReferenceType> tail, UnaryPredicate pred) {
+  ptrdiff_t count = 0;
+  auto visit = [&pred, &count](ReferenceType data) {
+    count += (pred(data) ? 1 : 0);
+    return false;
+  };
+  ::lem::__list_prefetch_walk(head, tail, visit);
+
+  return count;
+}
+template <typename InputIterator, typename T>
+inline typename iterator_traits<InputIterator>::difference_type
+count(InputIterator head, InputIterator tail, T const& value) {
+  return ::lem::count_if(head, tail, [&value](typename iterator_traits<InputIterator>::value_type const& data) -> bool {
+    return data == value;
+  });
+}
+/* end count_if() */
+/* end non-modifying sequence operations */
+
+/* binary search */
+// [head, tail) should be sorted;
+// lower_bound() returns the first element not less than value;
+template <typename ForwardIterator, typename T, typename Comp>
+ForwardIterator lower_bound(ForwardIterator head, ForwardIterator tail, T const& value, Comp islt) {
+  using diff_type = typename iterator_traits<ForwardIterator>::difference_type;
+
+  diff_type len = ::lem::distance(head, tail);
+  while (len > 0) {
+    diff_type half = len >> 1;
+    ForwardIterator mid = head;
+    ::lem::advance(mid, half);
+
+    if (islt(*mid, value)) {
+      head = ++mid;
+      len -= half + 1;
+    }
+    else {
+      len = half;
+    }
+  }
+
+  return head;
+}
+template <typename ForwardIterator, typename T>
+inline ForwardIterator lower_bound(ForwardIterator head, ForwardIterator tail, T const& value) {
+  return ::lem::lower_bound(head, tail, value, ::lem::less<T>());
+}
+// upper_bound() returns the first element greater than value;
+template <typename ForwardIterator, typename T, typename Comp>
+ForwardIterator upper_bound(ForwardIterator head, ForwardIterator tail, T const& value, Comp islt) {
+  using diff_type = typename iterator_traits<ForwardIterator>::difference_type;
+
+  diff_type len = ::lem::distance(head, tail);
+  while (len > 0) {
+    diff_type half = len >> 1;
+    ForwardIterator mid = head;
+    ::lem::advance(mid, half);
+
+    if (islt(value, *mid)) {
+      len = half;
+    }
+    else {
+      head = ++mid;
+      len -= half + 1;
+    }
+  }
+
+  return head;
+}
+template <typename ForwardIterator, typename T>
+inline ForwardIterator upper_bound(ForwardIterator head, ForwardIterator tail, T const& value) {
+  return ::lem::upper_bound(head, tail, value, ::lem::less<T>());
+}
+template <typename ForwardIterator, typename T, typename Comp>
+inline bool binary_search(ForwardIterator head, ForwardIterator tail, T const& value, Comp islt) {
+  ForwardIterator bound = ::lem::lower_bound(head, tail, value, islt);
+  return bound != tail && !islt(value, *bound);
+}
+template <typename ForwardIterator, typename T>
+inline bool binary_search(ForwardIterator head, ForwardIterator tail, T const& value) {
+  return ::lem::binary_search(head, tail, value, ::lem::less<T>());
+}
+/* end binary search */
+
+/* EM NOTE: galloping (exponential) search */
+// When a short sorted range (length m) is merged with a long one (length n),
+// comparing element by element costs O(n + m).
+// Instead, for each element of the short range, the long range is searched
+// from where the last search stopped: probe 1, 2, 4, 8, ... elements ahead
+// until the value is passed, then binary search in the last gap.
+// A search that skips k elements costs O(log k), so the whole merge costs O(m log(n / m)).
+//
+// Galloping is used by the algorithms below when both ranges are random access
+// and one is at least __kGallopRatio times longer than the other;
+// otherwise the plain linear merge is faster.
+constexpr ptrdiff_t __kGallopRatio = 8;
+
+template <typename RandomAccessIterator, typename T, typename Comp>
+RandomAccessIterator __gallop_lower_bound(RandomAccessIterator head, RandomAccessIterator tail, T const& value, Comp islt) {
+  using diff_type = typename iterator_traits<RandomAccessIterator>::difference_type;
+
+  // Every element before head + pred is less than value;
+  diff_type len = tail - head;
+  diff_type pred = 0;
+  diff_type bound = 0;
+  while (bound < len && islt(*(head + bound), value)) {
+    pred = bound + 1;
+    bound = 2 * bound + 1;
+  }
+
+  return ::lem::lower_bound(head + pred, head + (bound < len ? bound : len), value, islt);
+}
+template <typename RandomAccessIterator, typename T, typename Comp>
+RandomAccessIterator __gallop_upper_bound(RandomAccessIterator head, RandomAccessIterator tail, T const& value, Comp islt) {
+  using diff_type = typename iterator_traits<RandomAccessIterator>::difference_type;
+
+  // Every element before head + pred is not greater than value;
+  diff_type len = tail - head;
+  diff_type pred = 0;
+  diff_type bound = 0;
+  while (bound < len && !islt(value, *(head + bound))) {
+    pred = bound + 1;
+    bound = 2 * bound + 1;
+  }
+
+  return ::lem::upper_bound(head + pred, head + (bound < len ? bound : len), value, islt);
+}
+// which range to gallop in;
+enum class __gallop_side {
+  kNone, // similar lengths, merge linearly;
+  kFirst, // the first range is much longer;
+  kSecond // the second range is much longer;
+};
+template <typename RandomAccessIterator1, typename RandomAccessIterator2>
+inline __gallop_side __gallop_choose(RandomAccessIterator1 head1, RandomAccessIterator1 tail1,
+                                     RandomAccessIterator2 head2, RandomAccessIterator2 tail2) {
+  ptrdiff_t len1 = tail1 - head1;
+  ptrdiff_t len2 = tail2 - head2;
+
+  if (len1 >= __kGallopRatio * len2) {
+    return __gallop_side::kFirst;
+  }
+  if (len2 >= __kGallopRatio * len1) {
+    return __gallop_side::kSecond;
+  }
+
+  return __gallop_side::kNone;
+}
+/* end galloping search */
+
+/* merge() */
+// Merge two sorted ranges into result.
+// merge() is stable, i.e. equal elements from [head1, tail1) go first.
+template <typename InputIterator1, typename InputIterator2, typename OutputIterator, typename Comp>
+OutputIterator __merge(InputIterator1 head1, InputIterator1 tail1,
+                       InputIterator2 head2, InputIterator2 tail2,
+                       OutputIterator result, Comp islt,
+                       ::lem::input_iterator_tag, ::lem::input_iterator_tag) {
+  for (; head1 != tail1 && head2 != tail2; ++result) {
+    if (islt(*head2, *head1)) {
+      *result = *head2;
+      ++head2;
+    }
+    else {
+      *result = *head1;
+      ++head1;
+    }
+  }
+
+  return ::lem::copy(head2, tail2, ::lem::copy(head1, tail1, result));
+}
+template <typename RandomAccessIterator1, typename RandomAccessIterator2, typename OutputIterator, typename Comp>
+OutputIterator __merge(RandomAccessIterator1 head1, RandomAccessIterator1 tail1,
+                       RandomAccessIterator2 head2, RandomAccessIterator2 tail2,
+                       OutputIterator result, Comp islt,
+                       ::lem::random_access_iterator_tag, ::lem::random_access_iterator_tag) {
+  switch (::lem::__gallop_choose(head1, tail1, head2, tail2)) {
+  case __gallop_side::kFirst:
+    for (; head2 != tail2; ++head2, ++result) {
+      // elements equal to *head2 in the first range go first;
+      RandomAccessIterator1 bound = ::lem::__gallop_upper_bound(head1, tail1, *head2, islt);
+      result = ::lem::copy(head1, bound, result);
+      head1 = bound;
+      *result = *head2;
+    }
+    return ::lem::copy(head1, tail1, result);
+  case __gallop_side::kSecond:
+    for (; head1 != tail1; ++head1, ++result) {
+      RandomAccessIterator2 bound = ::lem::__gallop_lower_bound(head2, tail2, *head1, islt);
+      result = ::lem::copy(head2, bound, result);
+      head2 = bound;
+      *result = *head1;
+    }
+    return ::lem::copy(head2, tail2, result);
+  default:
+    return ::lem::__merge(head1, tail1, head2, tail2, result, islt,
+                          ::lem::input_iterator_tag(), ::lem::input_iterator_tag());
+  }
+}
+template <typename InputIterator1, typename InputIterator2, typename OutputIterator, typename Comp>
+inline OutputIterator merge(InputIterator1 head1, InputIterator1 tail1,
+                            InputIterator2 head2, InputIterator2 tail2,
+                            OutputIterator result, Comp islt) {
+  return ::lem::__merge(head1, tail1, head2, tail2, result, islt,
+                        ::lem::get_iterator_category(head1), ::lem::get_iterator_category(head2));
+}
+template <typename InputIterator1, typename InputIterator2, typename OutputIterator>
+inline OutputIterator merge(InputIterator1 head1, InputIterator1 tail1,
+                            InputIterator2 head2, InputIterator2 tail2,
+                            OutputIterator result) {
+  using value_type = typename iterator_traits<InputIterator1>::value_type;
+  return ::lem::merge(head1, tail1, head2, tail2, result, ::lem::less<value_type>());
+}
+/* end merge() */
+
+/* inplace_merge() */
+// Merge sorted [head, mid) and [mid, tail) into sorted [head, tail).
+// EM NOTE: the shorter range is copied to a temporary buffer,
+// then merged with the longer one back into [head, tail),
+// from the front if [head, mid) is buffered, or from the back otherwise.
+// The output never overtakes the unread part of the range being merged in place.
+
+// [bhead, btail) is the buffered [head, mid);
+template <typename BidirectionalIterator, typename T, typename Comp>
+void __merge_buffer_forward(T* bhead, T* btail, BidirectionalIterator mid, BidirectionalIterator tail,
+                            BidirectionalIterator result, Comp islt, ::lem::bidirectional_iterator_tag) {
+  for (; bhead != btail && mid != tail; ++result) {
+    if (islt(*mid, *bhead)) {
+      *result = ::std::move(*mid);
+      ++mid;
+    }
+    else {
+      *result = ::std::move(*bhead);
+      ++bhead;
+    }
+  }
+  // the rest of [mid, tail) is already in place;
+  for (; bhead != btail; ++bhead, ++result) {
+    *result = ::std::move(*bhead);
+  }
+
+  return;
+}
+template <typename RandomAccessIterator, typename T, typename Comp>
+void __merge_buffer_forward(T* bhead, T* btail, RandomAccessIterator mid, RandomAccessIterator tail,
+                            RandomAccessIterator result, Comp islt, ::lem::random_access_iterator_tag) {
+  if (::lem::__gallop_choose(bhead, btail, mid, tail) != __gallop_side::kSecond) {
+    ::lem::__merge_buffer_forward(bhead, btail, mid, tail, result, islt, ::lem::bidirectional_iterator_tag());
+
+    return;
+  }
+
+  for (; bhead != btail; ++bhead, ++result) {
+    RandomAccessIterator bound = ::lem::__gallop_lower_bound(mid, tail, *bhead, islt);
+    for (; mid != bound; ++mid, ++result) {
+      *result = ::std::move(*mid);
+    }
+    *result = ::std::move(*bhead);
+  }
+
+  return;
+}
+// [bhead, btail) is the buffered [mid, tail);
+template <typename BidirectionalIterator, typename T, typename Comp>
+void __merge_buffer_backward(BidirectionalIterator head, BidirectionalIterator mid, T* bhead, T* btail,
+                             BidirectionalIterator result_tail, Comp islt, ::lem::bidirectional_iterator_tag) {
+  while (mid != head && btail != bhead) {
+    BidirectionalIterator last = mid;
+    --last;
+    if (islt(*(btail - 1), *last)) {
+      *--result_tail = ::std::move(*last);
+      mid = last;
+    }
+    else {
+      *--result_tail = ::std::move(*--btail);
+    }
+  }
+  // the rest of [head, mid) is already in place;
+  while (btail != bhead) {
+    *--result_tail = ::std::move(*--btail);
+  }
+
+  return;
+}
+template <typename RandomAccessIterator, typename T, typename Comp>
+void __merge_buffer_backward(RandomAccessIterator head, RandomAccessIterator mid, T* bhead, T* btail,
+                             RandomAccessIterator result_tail, Comp islt, ::lem::random_access_iterator_tag) {
+  if (::lem::__gallop_choose(head, mid, bhead, btail) != __gallop_side::kFirst) {
+    ::lem::__merge_buffer_backward(head, mid, bhead, btail, result_tail, islt, ::lem::bidirectional_iterator_tag());
+
+    return;
+  }
+
+  // elements of [head, mid) greater than *(btail - 1) go after it;
+  while (btail != bhead) {
+    --btail;
+    RandomAccessIterator bound = ::lem::upper_bound(head, mid, *btail, islt);
+    while (mid != bound) {
+      *--result_tail = ::std::move(*--mid);
+    }
+    *--result_tail = ::std::move(*btail);
+  }
+
+  return;
+}
+template <typename BidirectionalIterator, typename Comp>
+void inplace_merge(BidirectionalIterator head, BidirectionalIterator mid, BidirectionalIterator tail, Comp islt) {
+  using value_type = typename iterator_traits<BidirectionalIterator>::value_type;
+  using buffer_allocator = ::lem::simple_alloc<value_type, ::lem::alloc>;
+
+  if (head == mid || mid == tail) {
+    return;
+  }
+
+  size_t len1 = (size_t)::lem::distance(head, mid);
+  size_t len2 = (size_t)::lem::distance(mid, tail);
+  size_t buffer_len = (len1 <= len2 ? len1 : len2);
+  value_type* buffer = buffer_allocator::allocate(buffer_len);
+  value_type* buffer_tail = buffer;
+
+  try {
+    if (len1 <= len2) {
+      for (BidirectionalIterator mov = head; mov != mid; ++mov, ++buffer_tail) {
+        ::lem::construct(buffer_tail, *mov);
+      }
+      ::lem::__merge_buffer_forward(buffer, buffer_tail, mid, tail, head, islt, ::lem::get_iterator_category(head));
+    }
+    else {
+      for (BidirectionalIterator mov = mid; mov != tail; ++mov, ++buffer_tail) {
+        ::lem::construct(buffer_tail, *mov);
+      }
+      ::lem::__merge_buffer_backward(head, mid, buffer, buffer_tail, tail, islt, ::lem::get_iterator_category(head));
+    }
+  }
+  catch (::std::exception const& e) {
+    // commit or rollback semantics;
+    ::lem::destroy(buffer, buffer_tail);
+    buffer_allocator::deallocate(buffer, buffer_len);
+    throw e;
+  }
+
+  ::lem::destroy(buffer, buffer_tail);
+  buffer_allocator::deallocate(buffer, buffer_len);
+
+  return;
+}
+template <typename BidirectionalIterator>
+inline void inplace_merge(BidirectionalIterator head, BidirectionalIterator mid, BidirectionalIterator tail) {
+  using value_type = typename iterator_traits<BidirectionalIterator>::value_type;
+  ::lem::inplace_merge(head, mid, tail, ::lem::less<value_type>());
+}
+/* end inplace_merge() */
+
+/* set algorithms */
+// EM NOTE: all the set algorithms work on sorted ranges with duplicates (multisets).
+// An element appearing m times in [head1, tail1) and n times in [head2, tail2)
+// appears max(m, n) times in union, min(m, n) times in intersection,
+// and max(m - n, 0) times in difference.
+// Equal elements are always taken from [head1, tail1) first.
+
+/* set_union() */
+template <typename InputIterator1, typename InputIterator2, typename OutputIterator, typename Comp>
+OutputIterator __set_union(InputIterator1 head1, InputIterator1 tail1,
+                           InputIterator2 head2, InputIterator2 tail2,
+                           OutputIterator result, Comp islt,
+                           ::lem::input_iterator_tag, ::lem::input_iterator_tag) {
+  for (; head1 != tail1 && head2 != tail2; ++result) {
+    if (islt(*head1, *head2)) {
+      *result = *head1;
+      ++head1;
+    }
+    else if (islt(*head2, *head1)) {
+      *result = *head2;
+      ++head2;
+    }
+    else {
+      *result = *head1;
+      ++head1;
+      ++head2;
+    }
+  }
+
+  return ::lem::copy(head2, tail2, ::lem::copy(head1, tail1, result));
+}
+template <typename RandomAccessIterator1, typename RandomAccessIterator2, typename OutputIterator, typename Comp>
+OutputIterator __set_union(RandomAccessIterator1 head1, RandomAccessIterator1 tail1,
+                           RandomAccessIterator2 head2, RandomAccessIterator2 tail2,
+                           OutputIterator result, Comp islt,
+                           ::lem::random_access_iterator_tag, ::lem::random_access_iterator_tag) {
+  switch (::lem::__gallop_choose(head1, tail1, head2, tail2)) {
+  case __gallop_side::kFirst:
+    for (; head2 != tail2; ++head2, ++result) {
+      RandomAccessIterator1 bound = ::lem::__gallop_lower_bound(head1, tail1, *head2, islt);
+      result = ::lem::copy(head1, bound, result);
+      head1 = bound;
+      if (head1 != tail1 && !islt(*head2, *head1)) { // a pair of equal elements;
+        *result = *head1;
+        ++head1;
+      }
+      else {
+        *result = *head2;
+      }
+    }
+    return ::lem::copy(head1, tail1, result);
+  case __gallop_side::kSecond:
+    for (; head1 != tail1; ++head1, ++result) {
+      RandomAccessIterator2 bound = ::lem::__gallop_lower_bound(head2, tail2, *head1, islt);
+      result = ::lem::copy(head2, bound, result);
+      head2 = bound;
+      if (head2 != tail2 && !islt(*head1, *head2)) { // a pair of equal elements;
+        ++head2;
+      }
+      *result = *head1;
+    }
+    return ::lem::copy(head2, tail2, result);
+  default:
+    return ::lem::__set_union(head1, tail1, head2, tail2, result, islt,
+                              ::lem::input_iterator_tag(), ::lem::input_iterator_tag());
+  }
+}
+template <typename InputIterator1, typename InputIterator2, typename OutputIterator, typename Comp>
+inline OutputIterator set_union(InputIterator1 head1, InputIterator1 tail1,
+                                InputIterator2 head2, InputIterator2 tail2,
+                                OutputIterator result, Comp islt) {
+  return ::lem::__set_union(head1, tail1, head2, tail2, result, islt,
+                            ::lem::get_iterator_category(head1), ::lem::get_iterator_category(head2));
+}
+template <typename InputIterator1, typename InputIterator2, typename OutputIterator>
+inline OutputIterator set_union(InputIterator1 head1, InputIterator1 tail1,
+                                InputIterator2 head2, InputIterator2 tail2,
+                                OutputIterator result) {
+  using value_type = typename iterator_traits<InputIterator1>::value_type;
+  return ::lem::set_union(head1, tail1, head2, tail2, result, ::lem::less<value_type>());
+}
+/* end set_union() */
+
+/* set_intersection() */
+template <typename InputIterator1, typename InputIterator2, typename OutputIterator, typename Comp>
+OutputIterator __set_intersection(InputIterator1 head1, InputIterator1 tail1,
+                                  InputIterator2 head2, InputIterator2 tail2,
+                                  OutputIterator result, Comp islt,
+                                  ::lem::input_iterator_tag, ::lem::input_iterator_tag) {
+  while (head1 != tail1 && head2 != tail2) {
+    if (islt(*head1, *head2)) {
+      ++head1;
+    }
+    else if (islt(*head2, *head1)) {
+      ++head2;
+    }
+    else {
+      *result = *head1;
+      ++result;
+      ++head1;
+      ++head2;
+    }
+  }
+
+  return result;
+}
+template <typename RandomAccessIterator1, typename RandomAccessIterator2, typename OutputIterator, typename Comp>
+OutputIterator __set_intersection(RandomAccessIterator1 head1, RandomAccessIterator1 tail1,
+                                  RandomAccessIterator2 head2, RandomAccessIterator2 tail2,
+                                  OutputIterator result, Comp islt,
+                                  ::lem::random_access_iterator_tag, ::lem::random_access_iterator_tag) {
+  switch (::lem::__gallop_choose(head1, tail1, head2, tail2)) {
+  case __gallop_side::kFirst:
+    for (; head2 != tail2 && head1 != tail1; ++head2) {
+      head1 = ::lem::__gallop_lower_bound(head1, tail1, *head2, islt);
+      if (head1 != tail1 && !islt(*head2, *head1)) {
+        *result = *head1;
+        ++result;
+        ++head1;
+      }
+    }
+    return result;
+  case __gallop_side::kSecond:
+    for (; head1 != tail1 && head2 != tail2; ++head1) {
+      head2 = ::lem::__gallop_lower_bound(head2, tail2, *head1, islt);
+      if (head2 != tail2 && !islt(*head1, *head2)) {
+        *result = *head1;
+        ++result;
+        ++head2;
+      }
+    }
+    return result;
+  default:
+    return ::lem::__set_intersection(head1, tail1, head2, tail2, result, islt,
+                                     ::lem::input_iterator_tag(), ::lem::input_iterator_tag());
+  }
+}
+template <typename InputIterator1, typename InputIterator2, typename OutputIterator, typename Comp>
+inline OutputIterator set_intersection(InputIterator1 head1, InputIterator1 tail1,
+                                       InputIterator2 head2, InputIterator2 tail2,
+                                       OutputIterator result, Comp islt) {
+  return ::lem::__set_intersection(head1, tail1, head2, tail2, result, islt,
+                                   ::lem::get_iterator_category(head1), ::lem::get_iterator_category(head2));
+}
+template <typename InputIterator1, typename InputIterator2, typename OutputIterator>
+inline OutputIterator set_intersection(InputIterator1 head1, InputIterator1 tail1,
+                                       InputIterator2 head2, InputIterator2 tail2,
+                                       OutputIterator result) {
+  using value_type = typename iterator_traits<InputIterator1>::value_type;
+  return ::lem::set_intersection(head1, tail1, head2, tail2, result, ::lem::less<value_type>());
+}
+/* end set_intersection() */
+
+/* set_difference() */
+// elements in [head1, tail1) but not in [head2, tail2);
+template <typename InputIterator1, typename InputIterator2, typename OutputIterator, typename Comp>
+OutputIterator __set_difference(InputIterator1 head1, InputIterator1 tail1,
+                                InputIterator2 head2, InputIterator2 tail2,
+                                OutputIterator result, Comp islt,
+                                ::lem::input_iterator_tag, ::lem::input_iterator_tag) {
+  while (head1 != tail1 && head2 != tail2) {
+    if (islt(*head1, *head2)) {
+      *result = *head1;
+      ++result;
+      ++head1;
+    }
+    else if (islt(*head2, *head1)) {
+      ++head2;
+    }
+    else {
+      ++head1;
+      ++head2;
+    }
+  }
+
+  return ::lem::copy(head1, tail1, result);
+}
+template <typename RandomAccessIterator1, typename RandomAccessIterator2, typename OutputIterator, typename Comp>
+OutputIterator __set_difference(RandomAccessIterator1 head1, RandomAccessIterator1 tail1,
+                                RandomAccessIterator2 head2, RandomAccessIterator2 tail2,
+                                OutputIterator result, Comp islt,
+                                ::lem::random_access_iterator_tag, ::lem::random_access_iterator_tag) {
+  switch (::lem::__gallop_choose(head1, tail1, head2, tail2)) {
+  case __gallop_side::kFirst:
+    // copy the gaps between elements of [head2, tail2);
+    for (; head2 != tail2 && head1 != tail1; ++head2) {
+      RandomAccessIterator1 bound = ::lem::__gallop_lower_bound(head1, tail1, *head2, islt);
+      result = ::lem::copy(head1, bound, result);
+      head1 = bound;
+      if (head1 != tail1 && !islt(*head2, *head1)) {
+        ++head1;
+      }
+    }
+    return ::lem::copy(head1, tail1, result);
+  case __gallop_side::kSecond:
+    for (; head1 != tail1; ++head1) {
+      head2 = ::lem::__gallop_lower_bound(head2, tail2, *head1, islt);
+      if (head2 != tail2 && !islt(*head1, *head2)) {
+        ++head2;
+      }
+      else {
+        *result = *head1;
+        ++result;
+      }
+    }
+    return result;
+  default:
+    return ::lem::__set_difference(head1, tail1, head2, tail2, result, islt,
+                                   ::lem::input_iterator_tag(), ::lem::input_iterator_tag());
+  }
+}
+template <typename InputIterator1, typename InputIterator2, typename OutputIterator, typename Comp>
+inline OutputIterator set_difference(InputIterator1 head1, InputIterator1 tail1,
+                                     InputIterator2 head2, InputIterator2 tail2,
+                                     OutputIterator result, Comp islt) {
+  return ::lem::__set_difference(head1, tail1, head2, tail2, result, islt,
+                                 ::lem::get_iterator_category(head1), ::lem::get_iterator_category(head2));
+}
+template <typename InputIterator1, typename InputIterator2, typename OutputIterator>
+inline OutputIterator set_difference(InputIterator1 head1, InputIterator1 tail1,
+                                     InputIterator2 head2, InputIterator2 tail2,
+                                     OutputIterator result) {
+  using value_type = typename iterator_traits<InputIterator1>::value_type;
+  return ::lem::set_difference(head1, tail1, head2, tail2, result, ::lem::less<value_type>());
+}
+/* end set_difference() */
+
+/* includes() */
+// whether every element of [head2, tail2) is in [head1, tail1);
+template <typename InputIterator1, typename InputIterator2, typename Comp>
+bool __includes(InputIterator1 head1, InputIterator1 tail1,
+                InputIterator2 head2, InputIterator2 tail2, Comp islt,
+                ::lem::input_iterator_tag, ::lem::input_iterator_tag) {
+  for (; head2 != tail2; ++head1) {
+    if (head1 == tail1 || islt(*head2, *head1)) {
+      return false;
+    }
+    if (!islt(*head1, *head2)) {
+      ++head2;
+    }
+  }
+
+  return true;
+}
+template <typename RandomAccessIterator1, typename RandomAccessIterator2, typename Comp>
+bool __includes(RandomAccessIterator1 head1, RandomAccessIterator1 tail1,
+                RandomAccessIterator2 head2, RandomAccessIterator2 tail2, Comp islt,
+                ::lem::random_access_iterator_tag, ::lem::random_access_iterator_tag) {
+  switch (::lem::__gallop_choose(head1, tail1, head2, tail2)) {
+  case __gallop_side::kFirst:
+    for (; head2 != tail2; ++head2, ++head1) {
+      head1 = ::lem::__gallop_lower_bound(head1, tail1, *head2, islt);
+      if (head1 == tail1 || islt(*head2, *head1)) {
+        return false;
+      }
+    }
+    return true;
+  case __gallop_side::kSecond: // a longer range cannot be included;
+    return false;
+  default:
+    return ::lem::__includes(head1, tail1, head2, tail2, islt,
+                             ::lem::input_iterator_tag(), ::lem::input_iterator_tag());
+  }
+}
+template <typename InputIterator1, typename InputIterator2, typename Comp>
+inline bool includes(InputIterator1 head1, InputIterator1 tail1,
+                     InputIterator2 head2, InputIterator2 tail2, Comp islt) {
+  return ::lem::__includes(head1, tail1, head2, tail2, islt,
+                           ::lem::get_iterator_category(head1), ::lem::get_iterator_category(head2));
+}
+template <typename InputIterator1, typename InputIterator2>
+inline bool includes(InputIterator1 head1, InputIterator1 tail1,
+                     InputIterator2 head2, InputIterator2 tail2) {
+  using value_type = typename iterator_traits<InputIterator1>::value_type;
+  return ::lem::includes(head1, tail1, head2, tail2, ::lem::less<value_type>());
+}
+/* end includes() */
+/* end set algorithms */
+
+/* remove_if() */
+// Move the elements not satisfying pred to the front, keeping their order,
+// and return the new logical end. The elements after it are left in valid but unspecified states.
+// EM NOTE: single pass, every kept element is moved at most once,
+// so erasing with remove_if() is O(n) instead of O(n^2) by erase() one by one.
+template <typename ForwardIterator, typename UnaryPredicate>
+ForwardIterator remove_if(ForwardIterator head, ForwardIterator tail, UnaryPredicate pred) {
+  // leading kept elements stay where they are;
+  while (head != tail && !pred(*head)) {
+    ++head;
+  }
+  if (head == tail) {
+    return tail;
+  }
+
+  ForwardIterator result = head;
+  for (++head; head != tail; ++head) {
+    if (!pred(*head)) {
+      *result = ::std::move(*head);
+      ++result;
+    }
+  }
+
+  return result;
+}
+/* end remove_if() */
+
+/* remove() */
+template <typename T>
+struct __equal_to_value {
+  T const& value_;
+
+  explicit __equal_to_value(T const& value) : value_(value) {}
+
+  template <typename U>
+  bool operator()(U const& data) const {
+    return data == value_;
+  }
+};
+
+// EM NOTE: compress kernels for native arithmetic types.
+// The fallback kernel is branchless: every element is written,
+// but the output position only advances if the element is kept,
+// so the loop does not suffer from mispredicted branches on random data.
+template <typename T>
+T* __kernel_remove(T* head, T* tail, T value) {
+  T* result = head;
+  for (; head != tail; ++head) {
+    T data = *head;
+    *result = data;
+    result += !(data == value);
+  }
+
+  return result;
+}
+
+#ifdef LEM_SIMD_AVX2
+/* AVX2 kernels */
+// EM NOTE: AVX2 has no compress-store instruction (that is AVX-512),
+// so the kept lanes are packed by a permutation looked up by the lane mask,
+// then all 8 lanes are stored and the output advances by the number of kept lanes.
+// The store never passes the loaded lanes, since result <= head.
+struct __compress_table {
+  ::std::uint32_t index[256][8];
+
+  __compress_table(void) {
+    for (unsigned mask = 0; mask < 256; ++mask) {
+      unsigned num = 0;
+      for (unsigned lane = 0; lane < 8; ++lane) {
+        if (mask & (1u << lane)) {
+          index[mask][num++] = lane;
+        }
+      }
+      for (; num < 8; ++num) {
+        index[mask][num] = 0;
+      }
+    }
+  }
+};
+inline __m256i __compress_index(unsigned mask) {
+  static __compress_table const table;
+  return _mm256_loadu_si256((__m256i const*)table.index[mask]);
+}
+inline unsigned __popcount8(unsigned mask) {
+  mask = mask - ((mask >> 1) & 0x55u);
+  mask = (mask & 0x33u) + ((mask >> 2) & 0x33u);
+  return (mask + (mask >> 4)) & 0x0Fu;
+}
+
+inline int* __kernel_remove(int* head, int* tail, int value) {
+  int* result = head;
+  __m256i target = _mm256_set1_epi32(value);
+
+  for (; tail - head >= 8; head += 8) {
+    __m256i data = _mm256_loadu_si256((__m256i const*)head);
+    __m256i equal = _mm256_cmpeq_epi32(data, target);
+    unsigned keep = ~(unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(equal)) & 0xFFu;
+    _mm256_storeu_si256((__m256i*)result, _mm256_permutevar8x32_epi32(data, ::lem::__compress_index(keep)));
+    result += ::lem::__popcount8(keep);
+  }
+  for (; head != tail; ++head) {
+    if (!(*head == value)) {
+      *result = *head;
+      ++result;
+    }
+  }
+
+  return result;
+}
+inline unsigned int* __kernel_remove(unsigned int* head, unsigned int* tail, unsigned int value) {
+  // equality does not depend on signedness;
+  return (unsigned int*)::lem::__kernel_remove((int*)head, (int*)tail, (int)value);
+}
+// EM NOTE: _CMP_EQ_OQ agrees with operator==, i.e. -0.0 equals 0.0 and NaN equals nothing;
+inline float* __kernel_remove(float* head, float* tail, float value) {
+  float* result = head;
+  __m256 target = _mm256_set1_ps(value);
+
+  for (; tail - head >= 8; head += 8) {
+    __m256 data = _mm256_loadu_ps(head);
+    unsigned keep = ~(unsigned)_mm256_movemask_ps(_mm256_cmp_ps(data, target, _CMP_EQ_OQ)) & 0xFFu;
+    _mm256_storeu_ps(result, _mm256_permutevar8x32_ps(data, ::lem::__compress_index(keep)));
+    result += ::lem::__popcount8(keep);
+  }
+  for (; head != tail; ++head) {
+    if (!(*head == value)) {
+      *result = *head;
+      ++result;
+    }
+  }
+
+  return result;
+}
+inline double* __kernel_remove(double* head, double* tail, double value) {
+  double* result = head;
+  __m256d target = _mm256_set1_pd(value);
+
+  for (; tail - head >= 4; head += 4) {
+    __m256d data = _mm256_loadu_pd(head);
+    unsigned keep = ~(unsigned)_mm256_movemask_pd(_mm256_cmp_pd(data, target, _CMP_EQ_OQ)) & 0x0Fu;
+    // a double is a pair of 32-bit lanes, so each bit of keep is doubled;
+    unsigned pair_keep = ((keep & 1u) * 3u) | ((keep & 2u) * 6u) | ((keep & 4u) * 12u) | ((keep & 8u) * 24u);
+    __m256i packed = _mm256_permutevar8x32_epi32(_mm256_castpd_si256(data), ::lem::__compress_index(pair_keep));
+    _mm256_storeu_pd(result, _mm256_castsi256_pd(packed));
+    result += ::lem::__popcount8(keep);
+  }
+  for (; head != tail; ++head) {
+    if (!(*head == value)) {
+      *result = *head;
+      ++result;
+    }
+  }
+
+  return result;
+}
+/* end AVX2 kernels */
+#endif /* LEM_SIMD_AVX2 */
+
+template <typename ForwardIterator, typename T>
+inline ForwardIterator __remove_aux(ForwardIterator head, ForwardIterator tail, T const& value, ::lem::__false_tag) {
+  return ::lem::remove_if(head, tail, ::lem::__equal_to_value<T>(value));
+}
+// native pointers to arithmetic types, value is of the element type;
+template <typename DataType>
+inline DataType* __remove_aux(DataType* head, DataType* tail, DataType const& value, ::lem::__true_tag) {
+  return ::lem::__kernel_remove(head, tail, value);
+}
+template <typename ContiguousIterator, typename T>
+inline ContiguousIterator __remove_aux(ContiguousIterator head, ContiguousIterator tail, T const& value, ::lem::__true_tag) {
+  auto first = ::lem::to_address(head);
+  return head + (::lem::__remove_aux(first, ::lem::to_address(tail), value, ::lem::__true_tag()) - first);
+}
+template <typename ForwardIterator, typename T>
+inline ForwardIterator remove(ForwardIterator head, ForwardIterator tail, T const& value) {
+  // EM NOTE: the kernels compare in the element type, so a value of another type
+  // (e.g. 2.5 in a range of int) takes the generic path, which compares as operator== does;
+  using has_kernel = typename __simd_dispatch<ForwardIterator, T>::has_kernel;
+
+  return ::lem::__remove_aux(head, tail, value, has_kernel());
+}
+/* end remove() */
+
+/* unique() */
+// Remove all but the first element from every group of consecutive equivalent elements,
+// and return the new logical end.
+template <typename ForwardIterator, typename BinaryPredicate>
+ForwardIterator unique(ForwardIterator head, ForwardIterator tail, BinaryPredicate pred) {
+  if (head == tail) {
+    return tail;
+  }
+
+  // leading distinct elements stay where they are;
+  ForwardIterator next = head;
+  while (++next != tail && !pred(*head, *next)) {
+    head = next;
+  }
+  if (next == tail) {
+    return tail;
+  }
+
+  // Now *head is the last kept element;
+  ForwardIterator result = head;
+  for (++next; next != tail; ++next) {
+    if (!pred(*result, *next)) {
+      *++result = ::std::move(*next);
+    }
+  }
+
+  return ++result;
+}
+template <typename ForwardIterator>
+inline ForwardIterator unique(ForwardIterator head, ForwardIterator tail) {
+  using value_type = typename iterator_traits<ForwardIterator>::value_type;
+  return ::lem::unique(head, tail, ::lem::equal_to<value_type>());
+}
+/* end unique() */
+
+/* partition() */
+// Move the elements satisfying pred before those not, and return the boundary.
+// partition() is not stable;
+template <typename ForwardIterator, typename UnaryPredicate>
+ForwardIterator __partition(ForwardIterator head, ForwardIterator tail, UnaryPredicate pred, ::lem::forward_iterator_tag) {
+  while (head != tail && pred(*head)) {
+    ++head;
+  }
+  if (head == tail) {
+    return tail;
+  }
+
+  ForwardIterator mov = head;
+  for (++mov; mov != tail; ++mov) {
+    if (pred(*mov)) {
+      ::lem::swap(*head, *mov);
+      ++head;
+    }
+  }
+
+  return head;
+}
+// EM NOTE: scan from both ends and swap misplaced pairs,
+// which moves every misplaced element exactly once.
+template <typename BidirectionalIterator, typename UnaryPredicate>
+BidirectionalIterator __partition(BidirectionalIterator head, BidirectionalIterator tail, UnaryPredicate pred, ::lem::bidirectional_iterator_tag) {
+  for (;;) {
+    for (;; ++head) {
+      if (head == tail) {
+        return head;
+      }
+      if (!pred(*head)) {
+        break;
+      }
+    }
+    do {
+      if (head == --tail) {
+        return head;
+      }
+    } while (!pred(*tail));
+
+    ::lem::swap(*head, *tail);
+    ++head;
+  }
+}
+template <typename ForwardIterator, typename UnaryPredicate>
+inline ForwardIterator partition(ForwardIterator head, ForwardIterator tail, UnaryPredicate pred) {
+  return ::lem::__partition(head, tail, pred, ::lem::get_iterator_category(head));
+}
+/* end partition() */
+
+/* stable_partition() */
+// EM NOTE: single pass with a temporary buffer:
+// elements satisfying pred are compacted in place as remove_if() does,
+// the others are moved to the buffer, and then appended after them.
+template <typename ForwardIterator, typename UnaryPredicate>
+ForwardIterator stable_partition(ForwardIterator head, ForwardIterator tail, UnaryPredicate pred) {
+  using value_type = typename iterator_traits<ForwardIterator>::value_type;
+  using buffer_allocator = ::lem::simple_alloc<value_type, ::lem::alloc>;
+
+  // leading elements satisfying pred stay where they are;
+  while (head != tail && pred(*head)) {
+    ++head;
+  }
+  if (head == tail) {
+    return tail;
+  }
+
+  size_t buffer_len = (size_t)::lem::distance(head, tail);
+  value_type* buffer = buffer_allocator::allocate(buffer_len);
+  value_type* buffer_tail = buffer;
+  ForwardIterator result = head;
+
+  try {
+    for (; head != tail; ++head) {
+      if (pred(*head)) {
+        *result = ::std::move(*head);
+        ++result;
+      }
+      else {
+        ::lem::construct(buffer_tail, *head);
+        ++buffer_tail;
+      }
+    }
+
+    ForwardIterator mov = result;
+    for (value_type* cur = buffer; cur != buffer_tail; ++cur, ++mov) {
+      *mov = ::std::move(*cur);
+    }
+  }
+  catch (::std::exception const& e) {
+    // commit or rollback semantics;
+    ::lem::destroy(buffer, buffer_tail);
+    buffer_allocator::deallocate(buffer, buffer_len);
+    throw e;
+  }
+
+  ::lem::destroy(buffer, buffer_tail);
+  buffer_allocator::deallocate(buffer, buffer_len);
+
+  return result;
+}
+/* end stable_partition() */
+
+/* reverse() */
+template <typename BidirectionalIterator>
+void __reverse(BidirectionalIterator head, BidirectionalIterator tail, ::lem::bidirectional_iterator_tag) {
+  while (head != tail && head != --tail) {
+    ::lem::iter_swap(head, tail);
+    ++head;
+  }
+
+  return;
+}
+template <typename RandomAccessIterator>
+void __reverse(RandomAccessIterator head, RandomAccessIterator tail, ::lem::random_access_iterator_tag) {
+  if (head == tail) {
+    return;
+  }
+
+  for (--tail; head < tail; ++head, --tail) {
+    ::lem::iter_swap(head, tail);
+  }
+
+  return;
+}
+
+// EM NOTE: a trivial element is moved as raw bytes, so only its size matters.
+// The kernels reverse 32-byte blocks from both ends at once,
+// i.e. load the front and back blocks, reverse the lanes of each, and store them swapped,
+// leaving less than 2 blocks in the middle to the scalar loop.
+template <size_t Size>
+struct __lane_size {};
+
+// no kernel for this size;
+template <typename T, size_t Size>
+inline void __reverse_simd(T*&, T*&, __lane_size<Size>) {}
+
+#ifdef LEM_SIMD_AVX2
+/* AVX2 kernels */
+// shuffle_epi8 only works within 128-bit halves, so the halves are swapped afterwards;
+inline __m256i __avx2_reverse_block(__m256i data, __lane_size<1>) {
+  __m256i index = _mm256_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+                                   15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+  return _mm256_permute4x64_epi64(_mm256_shuffle_epi8(data, index), 0x4E);
+}
+inline __m256i __avx2_reverse_block(__m256i data, __lane_size<2>) {
+  __m256i index = _mm256_setr_epi8(14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1,
+                                   14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1);
+  return _mm256_permute4x64_epi64(_mm256_shuffle_epi8(data, index), 0x4E);
+}
+inline __m256i __avx2_reverse_block(__m256i data, __lane_size<4>) {
+  return _mm256_permutevar8x32_epi32(data, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+}
+inline __m256i __avx2_reverse_block(__m256i data, __lane_size<8>) {
+  return _mm256_permute4x64_epi64(data, 0x1B);
+}
+template <typename T, size_t Size>
+void __avx2_reverse(T*& head, T*& tail, __lane_size<Size> lane) {
+  constexpr ptrdiff_t kLanes = 32 / Size;
+
+  while (tail - head >= 2 * kLanes) {
+    tail -= kLanes;
+    __m256i front = _mm256_loadu_si256((__m256i const*)head);
+    __m256i back = _mm256_loadu_si256((__m256i const*)tail);
+    _mm256_storeu_si256((__m256i*)head, ::lem::__avx2_reverse_block(back, lane));
+    _mm256_storeu_si256((__m256i*)tail, ::lem::__avx2_reverse_block(front, lane));
+    head += kLanes;
+  }
+
+  return;
+}
+template <typename T>
+inline void __reverse_simd(T*& head, T*& tail, __lane_size<1> lane) {
+  ::lem::__avx2_reverse(head, tail, lane);
+}
+template <typename T>
+inline void __reverse_simd(T*& head, T*& tail, __lane_size<2> lane) {
+  ::lem::__avx2_reverse(head, tail, lane);
+}
+template <typename T>
+inline void __reverse_simd(T*& head, T*& tail, __lane_size<4> lane) {
+  ::lem::__avx2_reverse(head, tail, lane);
+}
+template <typename T>
+inline void __reverse_simd(T*& head, T*& tail, __lane_size<8> lane) {
+  ::lem::__avx2_reverse(head, tail, lane);
+}
+/* end AVX2 kernels */
+#endif /* LEM_SIMD_AVX2 */
+
+template <typename T>
+inline void __reverse_native(T* head, T* tail, ::lem::__true_tag) {
+  ::lem::__reverse_simd(head, tail, __lane_size<sizeof(T)>());
+  ::lem::__reverse(head, tail, ::lem::random_access_iterator_tag());
+}
+template <typename T>
+inline void __reverse_native(T* head, T* tail, ::lem::__false_tag) {
+  ::lem::__reverse(head, tail, ::lem::random_access_iterator_tag());
+}
+template <typename BidirectionalIterator>
+inline void reverse(BidirectionalIterator head, BidirectionalIterator tail) {
+  ::lem::__reverse(head, tail, ::lem::get_iterator_category(head));
+}
+template <typename T>
+inline void reverse(T* head, T* tail) {
+  using triv_assgn = typename __type_traits<T>::has_trivial_assignment_oprtr;
+  ::lem::__reverse_native(head, tail, triv_assgn());
+}
+/* end reverse() */
+
+/* rotate() */
+// Rotate [head, tail) so that *mid becomes the first element,
+// and return the new position of *head, i.e. head + (tail - mid).
+
+// EM NOTE: block swap (Gries and Mills).
+// Swap the leading block with the block of the same length after mid,
+// then one of them is in place, and the rest is a smaller rotation.
+// Every element is swapped at most once more than necessary,
+// and there is no gcd() cycle walk with its scattered accesses.
+template <typename ForwardIterator>
+ForwardIterator __rotate(ForwardIterator head, ForwardIterator mid, ForwardIterator tail, ::lem::forward_iterator_tag) {
+  if (head == mid) {
+    return tail;
+  }
+  if (mid == tail) {
+    return head;
+  }
+
+  ForwardIterator next = mid;
+  do {
+    ::lem::iter_swap(head, next);
+    ++head;
+    ++next;
+    if (head == mid) {
+      mid = next;
+    }
+  } while (next != tail);
+
+  // Now *head is the original first element;
+  ForwardIterator result = head;
+  next = mid;
+  while (next != tail) {
+    ::lem::iter_swap(head, next);
+    ++head;
+    ++next;
+    if (head == mid) {
+      mid = next;
+    }
+    else if (next == tail) {
+      next = mid;
+    }
+  }
+
+  return result;
+}
+// three reversals;
+template <typename BidirectionalIterator>
+BidirectionalIterator __rotate(BidirectionalIterator head, BidirectionalIterator mid, BidirectionalIterator tail, ::lem::bidirectional_iterator_tag) {
+  if (head == mid) {
+    return tail;
+  }
+  if (mid == tail) {
+    return head;
+  }
+
+  ::lem::__reverse(head, mid, ::lem::bidirectional_iterator_tag());
+  ::lem::__reverse(mid, tail, ::lem::bidirectional_iterator_tag());
+  while (head != mid && mid != tail) {
+    ::lem::iter_swap(head, --tail);
+    ++head;
+  }
+
+  // reverse the part left over, and the result is where it ends;
+  if (head == mid) {
+    ::lem::__reverse(mid, tail, ::lem::bidirectional_iterator_tag());
+
+    return tail;
+  }
+  ::lem::__reverse(head, mid, ::lem::bidirectional_iterator_tag());
+
+  return head;
+}
+// block swap with swap_ranges();
+template <typename RandomAccessIterator>
+RandomAccessIterator __rotate(RandomAccessIterator head, RandomAccessIterator mid, RandomAccessIterator tail, ::lem::random_access_iterator_tag) {
+  using diff_type = typename iterator_traits<RandomAccessIterator>::difference_type;
+
+  RandomAccessIterator result = head + (tail - mid);
+  diff_type left = mid - head;
+  diff_type right = tail - mid;
+
+  while (left != 0 && right != 0) {
+    if (left <= right) { // [head, mid) goes to its place;
+      ::lem::swap_ranges(head, mid, mid);
+      head += left;
+      mid += left;
+      right -= left;
+    }
+    else { // [mid, tail) goes to its place;
+      ::lem::swap_ranges(head, head + right, mid);
+      head += right;
+      left -= right;
+    }
+  }
+
+  return result;
+}
+
+// EM NOTE: rotation by a few elements, e.g. a sliding window, is done with a stack buffer:
+// save the short side, move the long side with one bulk copy, and put the short side back.
+// Longer sides are first cut down by block swaps.
+constexpr size_t __kRotateBufferBytes = 512;
+
+template <typename T>
+void __rotate_buffered(T* head, T* mid, T* tail) {
+  alignas(32) unsigned char buffer[__kRotateBufferBytes];
+  size_t left = (mid - head) * sizeof(T);
+  size_t right = (tail - mid) * sizeof(T);
+
+  if (left <= right) {
+    ::lem::__bulk_move(buffer, head, left);
+    ::lem::__bulk_move(head, mid, right);
+    ::lem::__bulk_move((unsigned char*)head + right, buffer, left);
+  }
+  else {
+    ::lem::__bulk_move(buffer, mid, right);
+    ::lem::__bulk_move((unsigned char*)head + right, head, left);
+    ::lem::__bulk_move(head, buffer, right);
+  }
+
+  return;
+}
+template <typename T>
+T* __rotate_native(T* head, T* mid, T* tail, ::lem::__true_tag) {
+  T* result = head + (tail - mid);
+  ptrdiff_t left = mid - head;
+  ptrdiff_t right = tail - mid;
+
+  while (left != 0 && right != 0) {
+    if ((size_t)(left <= right ? left : right) * sizeof(T) <= __kRotateBufferBytes) {
+      ::lem::__rotate_buffered(head, mid, tail);
+
+      break;
+    }
+
+    if (left <= right) {
+      ::lem::swap_ranges(head, mid, mid);
+      head += left;
+      mid += left;
+      right -= left;
+    }
+    else {
+      ::lem::swap_ranges(head, head + right, mid);
+      head += right;
+      left -= right;
+    }
+  }
+
+  return result;
+}
+template <typename T>
+inline T* __rotate_native(T* head, T* mid, T* tail, ::lem::__false_tag) {
+  return ::lem::__rotate(head, mid, tail, ::lem::random_access_iterator_tag());
+}
+template <typename ForwardIterator>
+inline ForwardIterator rotate(ForwardIterator head, ForwardIterator mid, ForwardIterator tail) {
+  return ::lem::__rotate(head, mid, tail, ::lem::get_iterator_category(head));
+}
+template <typename T>
+inline T* rotate(T* head, T* mid, T* tail) {
+  using triv_assgn = typename __type_traits<T>::has_trivial_assignment_oprtr;
+  return ::lem::__rotate_native(head, mid, tail, triv_assgn());
+}
+/* end rotate() */
+} /* end lem */
+
+#endif /* LEMSTL_LEM_ALGO_H_ */
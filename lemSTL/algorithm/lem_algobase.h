@@ -1,29 +1,95 @@
 #ifndef LEMSTL_LEM_ALGOBASE_H_
 #define LEMSTL_LEM_ALGOBASE_H_
 
-#include <cstring> // for memmove();
-
-#include "../lem_iterator" // for iterator tags;
+#include "../lem_iterator" // for iterator tags and to_address();
 #include "../lem_type_traits" // for __type_traits;
+#include <cstring> // for memset();
+#include <utility> // for std::move();
+
+#include "lem_bulk_copy.h" // for __bulk_move();
 
 namespace lem {
+/* fill() & fill_n() */
+// EM NOTE: contiguous iterators are unwrapped to native pointers,
+// where single byte elements are filled by memset()
+// and the other loops have no iterator overhead to vectorize.
 template <typename ForwardIterator, typename T>
-void fill(ForwardIterator head, ForwardIterator tail, T const& value) {
+void __fill(ForwardIterator head, ForwardIterator tail, T const& value, ::lem::__false_tag) {
+  for (; head != tail; ++head) {
+    *head = value;
+  }
+
+  return;
+}
+template <typename T, typename ValueType>
+inline void __fill_native(T* head, T* tail, ValueType const& value) {
   for (; head != tail; ++head) {
     *head = value;
   }
 
   return;
 }
+template <typename ValueType>
+inline void __fill_native(char* head, char* tail, ValueType const& value) {
+  ::std::memset(head, (unsigned char)(char)value, tail - head);
+}
+template <typename ValueType>
+inline void __fill_native(signed char* head, signed char* tail, ValueType const& value) {
+  ::std::memset(head, (unsigned char)(signed char)value, tail - head);
+}
+template <typename ValueType>
+inline void __fill_native(unsigned char* head, unsigned char* tail, ValueType const& value) {
+  ::std::memset(head, (unsigned char)value, tail - head);
+}
+template <typename ContiguousIterator, typename T>
+inline void __fill(ContiguousIterator head, ContiguousIterator tail, T const& value, ::lem::__true_tag) {
+  ::lem::__fill_native(::lem::to_address(head), ::lem::to_address(tail), value);
+}
+// segmented iterators are filled a segment at a time;
+template <typename ForwardIterator, typename T>
+inline void __fill_segmented(ForwardIterator head, ForwardIterator tail, T const& value, ::lem::__false_tag) {
+  using is_contiguous = typename __iterator_contiguity<ForwardIterator>::type;
+  ::lem::__fill(head, tail, value, is_contiguous());
+}
+template <typename SegmentedIterator, typename T>
+inline void __fill_segmented(SegmentedIterator head, SegmentedIterator tail, T const& value, ::lem::__true_tag) {
+  using local_iterator = typename __segmented_iterator_traits<SegmentedIterator>::local_iterator;
+
+  auto visit = [&value](local_iterator local_head, local_iterator local_tail) {
+    ::lem::__fill_native(local_head, local_tail, value);
+  };
+  ::lem::__for_each_segment(head, tail, visit);
+}
+template <typename ForwardIterator, typename T>
+inline void fill(ForwardIterator head, ForwardIterator tail, T const& value) {
+  ::lem::__fill_segmented(head, tail, value, __is_segmented_iterator<ForwardIterator>());
+}
 
 template <typename OutputIterator, typename SizeType, typename T>
-OutputIterator fill_n(OutputIterator head, SizeType n, T const& value) {
+OutputIterator __fill_n(OutputIterator head, SizeType n, T const& value, ::lem::__false_tag) {
   for (; n != 0; --n, ++head) {
     *head = value;
   }
 
   return head;
 }
+template <typename ContiguousIterator, typename SizeType, typename T>
+inline ContiguousIterator __fill_n(ContiguousIterator head, SizeType n, T const& value, ::lem::__true_tag) {
+  if (n <= 0) {
+    return head;
+  }
+
+  auto first = ::lem::to_address(head);
+  ::lem::__fill_native(first, first + n, value);
+
+  return head + n;
+}
+template <typename OutputIterator, typename SizeType, typename T>
+inline OutputIterator fill_n(OutputIterator head, SizeType n, T const& value) {
+  using is_contiguous = typename __iterator_contiguity<OutputIterator>::type;
+  return ::lem::__fill_n(head, n, value, is_contiguous());
+}
+/* end fill() & fill_n() */
 
 /* EM NOTE: copy() */
 // copy()
@@ -32,10 +98,13 @@ OutputIterator fill_n(OutputIterator head, SizeType n, T const& value) {
 //        |
 //        +----native pointer---->__copy_native()
 //        |                       |
-//        |                       +----trivial assignment oprtr---->memmove()
+//        |                       +----trivial assignment oprtr---->__bulk_move()
 //        |                       |
 //        |                       +----else------------------
 //        |                                                 |
+//        +----contiguous iterators---->to_address()        |
+//        |                             and native pointer  |
+//        |                                                 |
 //        +----else---->__copy()                            |
 //                      |                                   v
 //                      +----random access iterator---->__copy_class()
@@ -68,13 +137,36 @@ template <typename InputIterator, typename OutputIterator>
 class __copy_dispatch {
  public:
   OutputIterator operator()(InputIterator head, InputIterator tail, OutputIterator result) {
+    using is_contiguous = decltype(::lem::__tag_and(typename __iterator_contiguity<InputIterator>::type(),
+                                                    typename __iterator_contiguity<OutputIterator>::type()));
+    return copy(head, tail, result, is_contiguous());
+  }
+
+ private:
+  OutputIterator copy(InputIterator head, InputIterator tail, OutputIterator result, ::lem::__false_tag) {
     return __copy(head, tail, result, ::lem::get_iterator_category(head));
   }
+  // unwrap both sides and copy between native pointers;
+  OutputIterator copy(InputIterator head, InputIterator tail, OutputIterator result, ::lem::__true_tag) {
+    auto first = ::lem::to_address(head);
+    auto result_first = ::lem::to_address(result);
+    using native_dispatch = __copy_dispatch<decltype(first), decltype(result_first)>;
+
+    return result + (native_dispatch()(first, ::lem::to_address(tail), result_first) - result_first);
+  }
 };
   /* deal with native pointers */
+  // pointers to different types;
+  template <typename T, typename U>
+  class __copy_dispatch<T*, U*> {
+   public:
+    U* operator()(T* head, T* tail, U* result) {
+      return __copy(head, tail, result, ::lem::random_access_iterator_tag());
+    }
+  };
   template <typename T>
   inline T* __copy_native(const T* head, const T* tail, T* result, ::lem::__true_tag) {
-    ::std::memmove(result, head, sizeof(T) * (tail - head));
+    ::lem::__bulk_move(result, head, sizeof(T) * (tail - head));
 
     return result + (tail - head);
   }
@@ -107,7 +199,7 @@ inline OutputIterator copy(InputIterator head, InputIterator tail, OutputIterato
 }
 // specialization for char pointers;
 inline char* copy(const char* head, const char* tail, char* result) {
-  ::std::memmove(result, head, tail - head);
+  ::lem::__bulk_move(result, head, tail - head);
 
   return result + (tail - head);
 }
@@ -116,16 +208,16 @@ inline char* copy(const char* head, const char* tail, char* result) {
 /* copy_backward() */
 template <typename RandomAccessIterator, typename BidirectionalIterator, typename DiffType>
 BidirectionalIterator __copy_backward_class(RandomAccessIterator head, RandomAccessIterator tail, BidirectionalIterator result_tail, DiffType*) {
-  for (DiffType n = tail - head; n > 0; --tail, --result_tail, --n) {
-    *result_tail = *tail;
+  for (DiffType n = tail - head; n > 0; --n) {
+    *--result_tail = *--tail;
   }
 
   return result_tail;
 }
 template <typename BidirectionalIterator1, typename BidirectionalIterator2>
 BidirectionalIterator2 __copy_backward(BidirectionalIterator1 head, BidirectionalIterator1 tail, BidirectionalIterator2 result_tail, ::lem::input_iterator_tag) {
-  for (; head != tail; --tail, --result_tail) {
-    *result_tail = *tail;
+  while (head != tail) {
+    *--result_tail = *--tail;
   }
 
   return result_tail;
@@ -139,13 +231,36 @@ template <typename BidirectionalIterator1, typename BidirectionalIterator2>
 class __copy_backward_dispatch {
   public:
   BidirectionalIterator2 operator()(BidirectionalIterator1 head, BidirectionalIterator1 tail, BidirectionalIterator2 result_tail) {
+    using is_contiguous = decltype(::lem::__tag_and(typename __iterator_contiguity<BidirectionalIterator1>::type(),
+                                                    typename __iterator_contiguity<BidirectionalIterator2>::type()));
+    return copy_backward(head, tail, result_tail, is_contiguous());
+  }
+
+  private:
+  BidirectionalIterator2 copy_backward(BidirectionalIterator1 head, BidirectionalIterator1 tail, BidirectionalIterator2 result_tail, ::lem::__false_tag) {
     return __copy_backward(head, tail, result_tail, ::lem::get_iterator_category(head));
   }
+  // unwrap both sides and copy between native pointers;
+  BidirectionalIterator2 copy_backward(BidirectionalIterator1 head, BidirectionalIterator1 tail, BidirectionalIterator2 result_tail, ::lem::__true_tag) {
+    auto first = ::lem::to_address(head);
+    auto result_last = ::lem::to_address(result_tail);
+    using native_dispatch = __copy_backward_dispatch<decltype(first), decltype(result_last)>;
+
+    return result_tail - (result_last - native_dispatch()(first, ::lem::to_address(tail), result_last));
+  }
 };
   /* deal with native pointers */
+  // pointers to different types;
+  template <typename T, typename U>
+  class __copy_backward_dispatch<T*, U*> {
+    public:
+    U* operator()(T* head, T* tail, U* result_tail) {
+      return __copy_backward(head, tail, result_tail, ::lem::random_access_iterator_tag());
+    }
+  };
   template <typename T>
   inline T* __copy_backward_native(const T* head, const T* tail, T* result_tail, __true_tag) {
-    ::std::memmove(result_tail - (tail - head), head, sizeof(T) * (tail - head));
+    ::lem::__bulk_move(result_tail - (tail - head), head, sizeof(T) * (tail - head));
 
     return result_tail - (tail - head);
   }
@@ -176,7 +291,7 @@ inline BidirectionalIterator2 copy_backward(BidirectionalIterator1 head, Bidirec
 }
 // specialization for char pointers;
 inline char* copy_backward(const char* head, const char* tail, char* result_tail) {
-  ::std::memmove(result_tail - (tail - head), head, tail - head);
+  ::lem::__bulk_move(result_tail - (tail - head), head, tail - head);
 
   return result_tail - (tail - head);
 }
@@ -202,13 +317,62 @@ inline T const& max(T const& a, T const& b, Comp islt) {
 /* end max & min */
 
 /* swap */
+// Containers with a member swap() overload this one to exchange their memory;
 template <typename T>
 inline void swap(T& a, T& b) {
-  T temp = a;
-  a = b;
-  b = temp;
+  T temp = ::std::move(a);
+  a = ::std::move(b);
+  b = ::std::move(temp);
+}
+template <typename ForwardIterator1, typename ForwardIterator2>
+inline void iter_swap(ForwardIterator1 a, ForwardIterator2 b) {
+  ::lem::swap(*a, *b);
 }
 /* end swap */
+
+/* swap_ranges() */
+// Swap [head1, tail1) with the range of the same length starting at head2,
+// and return the end of the second range. The ranges should not overlap.
+template <typename ForwardIterator1, typename ForwardIterator2>
+ForwardIterator2 __swap_ranges(ForwardIterator1 head1, ForwardIterator1 tail1, ForwardIterator2 head2, ::lem::__false_tag) {
+  for (; head1 != tail1; ++head1, ++head2) {
+    ::lem::iter_swap(head1, head2);
+  }
+
+  return head2;
+}
+// EM NOTE: trivial elements are swapped in blocks through a small stack buffer,
+// i.e. 3 bulk copies per block instead of 3 assignments per element.
+constexpr size_t __kSwapBlockBytes = 256;
+
+template <typename T>
+T* __swap_ranges(T* head1, T* tail1, T* head2, ::lem::__true_tag) {
+  constexpr size_t kBlock = (__kSwapBlockBytes / sizeof(T) > 0 ? __kSwapBlockBytes / sizeof(T) : 1);
+  alignas(32) unsigned char buffer[kBlock * sizeof(T)];
+
+  while (head1 != tail1) {
+    size_t num = (size_t)(tail1 - head1) < kBlock ? (size_t)(tail1 - head1) : kBlock;
+    size_t bytes = num * sizeof(T);
+
+    ::lem::__bulk_move(buffer, head1, bytes);
+    ::lem::__bulk_move(head1, head2, bytes);
+    ::lem::__bulk_move(head2, buffer, bytes);
+    head1 += num;
+    head2 += num;
+  }
+
+  return head2;
+}
+template <typename ForwardIterator1, typename ForwardIterator2>
+inline ForwardIterator2 swap_ranges(ForwardIterator1 head1, ForwardIterator1 tail1, ForwardIterator2 head2) {
+  return ::lem::__swap_ranges(head1, tail1, head2, __false_tag());
+}
+template <typename T>
+inline T* swap_ranges(T* head1, T* tail1, T* head2) {
+  using triv_assgn = typename __type_traits<T>::has_trivial_assignment_oprtr;
+  return ::lem::__swap_ranges(head1, tail1, head2, triv_assgn());
+}
+/* end swap_ranges() */
 } /* end lem */
 
 #endif /* LEMSTL_LEM_ALGORITHM_H_ */
\ No newline at end of file
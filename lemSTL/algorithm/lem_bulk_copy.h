@@ -0,0 +1,245 @@
+// Tiered bulk copy of trivially assignable ranges;
+#ifndef LEMSTL_LEM_BULK_COPY_H_
+#define LEMSTL_LEM_BULK_COPY_H_
+
+#include <cstddef> // for size_t;
+#include <cstdint> // for uintptr_t and fixed width integers;
+#include <cstring> // for memcpy() and memmove();
+
+#include "lem_simd.h" // for SIMD settings;
+
+/* bulk copy settings */
+// Ranges of at least LEM_NONTEMPORAL_THRESHOLD bytes are copied with
+// non-temporal (streaming) stores, which bypass the cache.
+// It should be about the size of the last level cache,
+// since a copy larger than that would evict the whole working set
+// and could not stay in cache anyway.
+#ifndef LEM_NONTEMPORAL_THRESHOLD
+# define LEM_NONTEMPORAL_THRESHOLD (size_t(16) << 20) // 16 MB;
+#endif /* LEM_NONTEMPORAL_THRESHOLD */
+/* end bulk copy settings */
+
+namespace lem {
+/* EM NOTE: __bulk_move() */
+// __bulk_move() has the semantics of memmove(), i.e. the ranges may overlap.
+// __bulk_move()
+// |
+// +----bytes <= __kBulkTiny---->__bulk_copy_tiny()
+// |
+// +----AVX2---->dst does not overlap src from behind
+// |             |
+// |             +----disjoint and bytes >= LEM_NONTEMPORAL_THRESHOLD---->__avx2_stream_copy()
+// |             |
+// |             +----else---->__avx2_copy_forward()
+// |             |
+// |             +----else---->__avx2_copy_backward()
+// |
+// +----else---->memmove()
+
+constexpr size_t __kBulkTiny = 64;
+
+// EM NOTE: once inlined into a caller, GCC cannot always relate bytes
+// to the objects behind dst and src, e.g. the size of inplace_vector<int, 4>
+// never exceeds 4, or an empty vector has no memory, and warns about the
+// branches it believes reachable for larger sizes. They are false positives,
+// so the warnings are silenced for the code below, for GCC only;
+#if defined(__GNUC__) && !defined(__clang__)
+# pragma GCC diagnostic push
+# pragma GCC diagnostic ignored "-Warray-bounds"
+# pragma GCC diagnostic ignored "-Wstringop-overflow"
+# pragma GCC diagnostic ignored "-Wnonnull"
+# pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+# if __GNUC__ >= 11
+#  pragma GCC diagnostic ignored "-Wstringop-overread"
+# endif /* __GNUC__ >= 11 */
+#endif /* __GNUC__ */
+
+struct __bulk_chunk16 {
+  unsigned char data_[16];
+};
+
+// bytes <= __kBulkTiny;
+// EM NOTE: a few fixed size, possibly overlapping chunks cover the range,
+// e.g. 13 bytes are copied as bytes [0, 8) and [5, 13).
+// All the chunks are loaded before any is stored,
+// so overlapping ranges are safe in either direction.
+// Fixed size memcpy() compiles to single loads and stores, without calls.
+inline void __bulk_copy_tiny(unsigned char* dst, unsigned char const* src, size_t bytes) {
+  if (bytes > 32) {
+    __bulk_chunk16 chunk0, chunk1, chunk2, chunk3;
+    ::std::memcpy(&chunk0, src, 16);
+    ::std::memcpy(&chunk1, src + 16, 16);
+    ::std::memcpy(&chunk2, src + bytes - 32, 16);
+    ::std::memcpy(&chunk3, src + bytes - 16, 16);
+    ::std::memcpy(dst, &chunk0, 16);
+    ::std::memcpy(dst + 16, &chunk1, 16);
+    ::std::memcpy(dst + bytes - 32, &chunk2, 16);
+    ::std::memcpy(dst + bytes - 16, &chunk3, 16);
+  }
+  else if (bytes >= 16) {
+    __bulk_chunk16 chunk0, chunk1;
+    ::std::memcpy(&chunk0, src, 16);
+    ::std::memcpy(&chunk1, src + bytes - 16, 16);
+    ::std::memcpy(dst, &chunk0, 16);
+    ::std::memcpy(dst + bytes - 16, &chunk1, 16);
+  }
+  else if (bytes >= 8) {
+    ::std::uint64_t chunk0, chunk1;
+    ::std::memcpy(&chunk0, src, 8);
+    ::std::memcpy(&chunk1, src + bytes - 8, 8);
+    ::std::memcpy(dst, &chunk0, 8);
+    ::std::memcpy(dst + bytes - 8, &chunk1, 8);
+  }
+  else if (bytes >= 4) {
+    ::std::uint32_t chunk0, chunk1;
+    ::std::memcpy(&chunk0, src, 4);
+    ::std::memcpy(&chunk1, src + bytes - 4, 4);
+    ::std::memcpy(dst, &chunk0, 4);
+    ::std::memcpy(dst + bytes - 4, &chunk1, 4);
+  }
+  else if (bytes >= 2) {
+    ::std::uint16_t chunk0, chunk1;
+    ::std::memcpy(&chunk0, src, 2);
+    ::std::memcpy(&chunk1, src + bytes - 2, 2);
+    ::std::memcpy(dst, &chunk0, 2);
+    ::std::memcpy(dst + bytes - 2, &chunk1, 2);
+  }
+  else if (bytes == 1) {
+    *dst = *src;
+  }
+
+  return;
+}
+
+#ifdef LEM_SIMD_AVX2
+/* AVX2 kernels */
+// bytes > __kBulkTiny for all the kernels below.
+
+// dst <= src, or the ranges do not overlap;
+// EM NOTE: the last 32 bytes are loaded first and stored last,
+// so the loop needs no scalar tail.
+// Each store is below the loads of the same round,
+// so it never overwrites source bytes not yet loaded.
+inline void __avx2_copy_forward(unsigned char* dst, unsigned char const* src, size_t bytes) {
+  __m256i last = _mm256_loadu_si256((__m256i const*)(src + bytes - 32));
+  unsigned char* dst_last = dst + bytes - 32;
+
+  for (; bytes > 128; bytes -= 128, src += 128, dst += 128) {
+    __m256i data0 = _mm256_loadu_si256((__m256i const*)src);
+    __m256i data1 = _mm256_loadu_si256((__m256i const*)(src + 32));
+    __m256i data2 = _mm256_loadu_si256((__m256i const*)(src + 64));
+    __m256i data3 = _mm256_loadu_si256((__m256i const*)(src + 96));
+    _mm256_storeu_si256((__m256i*)dst, data0);
+    _mm256_storeu_si256((__m256i*)(dst + 32), data1);
+    _mm256_storeu_si256((__m256i*)(dst + 64), data2);
+    _mm256_storeu_si256((__m256i*)(dst + 96), data3);
+  }
+  for (; bytes > 32; bytes -= 32, src += 32, dst += 32) {
+    _mm256_storeu_si256((__m256i*)dst, _mm256_loadu_si256((__m256i const*)src));
+  }
+  _mm256_storeu_si256((__m256i*)dst_last, last);
+
+  return;
+}
+// dst > src and the ranges overlap, mirror of __avx2_copy_forward();
+inline void __avx2_copy_backward(unsigned char* dst, unsigned char const* src, size_t bytes) {
+  __m256i first = _mm256_loadu_si256((__m256i const*)src);
+  unsigned char* dst_first = dst;
+
+  for (; bytes > 128; bytes -= 128) {
+    __m256i data0 = _mm256_loadu_si256((__m256i const*)(src + bytes - 32));
+    __m256i data1 = _mm256_loadu_si256((__m256i const*)(src + bytes - 64));
+    __m256i data2 = _mm256_loadu_si256((__m256i const*)(src + bytes - 96));
+    __m256i data3 = _mm256_loadu_si256((__m256i const*)(src + bytes - 128));
+    _mm256_storeu_si256((__m256i*)(dst + bytes - 32), data0);
+    _mm256_storeu_si256((__m256i*)(dst + bytes - 64), data1);
+    _mm256_storeu_si256((__m256i*)(dst + bytes - 96), data2);
+    _mm256_storeu_si256((__m256i*)(dst + bytes - 128), data3);
+  }
+  for (; bytes > 32; bytes -= 32) {
+    _mm256_storeu_si256((__m256i*)(dst + bytes - 32), _mm256_loadu_si256((__m256i const*)(src + bytes - 32)));
+  }
+  _mm256_storeu_si256((__m256i*)dst_first, first);
+
+  return;
+}
+
+// disjoint ranges only;
+// EM NOTE: streaming stores write whole lines to memory without reading them
+// into the cache first, and the source is prefetched with the NTA hint,
+// which keeps it out of the outer cache levels.
+// Streaming stores need 32-byte aligned addresses, so the unaligned head of dst
+// is copied separately. The final sfence orders the streaming stores
+// before any later store, as they are weakly ordered.
+constexpr size_t __kPrefetchDistance = 512; // bytes ahead of the loads;
+
+inline void __avx2_stream_copy(unsigned char* dst, unsigned char const* src, size_t bytes) {
+  size_t head_bytes = (32 - ((::std::uintptr_t)dst & 31)) & 31;
+  ::lem::__bulk_copy_tiny(dst, src, head_bytes);
+  dst += head_bytes;
+  src += head_bytes;
+  bytes -= head_bytes;
+
+  for (; bytes >= 128; bytes -= 128, src += 128, dst += 128) {
+    _mm_prefetch((char const*)(src + __kPrefetchDistance), _MM_HINT_NTA);
+    _mm_prefetch((char const*)(src + __kPrefetchDistance + 64), _MM_HINT_NTA);
+    __m256i data0 = _mm256_loadu_si256((__m256i const*)src);
+    __m256i data1 = _mm256_loadu_si256((__m256i const*)(src + 32));
+    __m256i data2 = _mm256_loadu_si256((__m256i const*)(src + 64));
+    __m256i data3 = _mm256_loadu_si256((__m256i const*)(src + 96));
+    _mm256_stream_si256((__m256i*)dst, data0);
+    _mm256_stream_si256((__m256i*)(dst + 32), data1);
+    _mm256_stream_si256((__m256i*)(dst + 64), data2);
+    _mm256_stream_si256((__m256i*)(dst + 96), data3);
+  }
+  _mm_sfence();
+
+  if (bytes > __kBulkTiny) {
+    ::lem::__avx2_copy_forward(dst, src, bytes);
+  }
+  else {
+    ::lem::__bulk_copy_tiny(dst, src, bytes);
+  }
+
+  return;
+}
+/* end AVX2 kernels */
+#endif /* LEM_SIMD_AVX2 */
+
+inline void __bulk_move(void* dst_ptr, void const* src_ptr, size_t bytes) {
+  unsigned char* dst = (unsigned char*)dst_ptr;
+  unsigned char const* src = (unsigned char const*)src_ptr;
+
+  if (bytes <= __kBulkTiny) {
+    ::lem::__bulk_copy_tiny(dst, src, bytes);
+
+    return;
+  }
+
+#ifdef LEM_SIMD_AVX2
+  ::std::uintptr_t dst_addr = (::std::uintptr_t)dst;
+  ::std::uintptr_t src_addr = (::std::uintptr_t)src;
+  if (dst_addr <= src_addr || dst_addr >= src_addr + bytes) {
+    if (bytes >= LEM_NONTEMPORAL_THRESHOLD && (dst_addr + bytes <= src_addr || dst_addr >= src_addr + bytes)) {
+      ::lem::__avx2_stream_copy(dst, src, bytes);
+    }
+    else {
+      ::lem::__avx2_copy_forward(dst, src, bytes);
+    }
+  }
+  else {
+    ::lem::__avx2_copy_backward(dst, src, bytes);
+  }
+#else
+  ::std::memmove(dst, src, bytes);
+#endif /* LEM_SIMD_AVX2 */
+
+  return;
+}
+#if defined(__GNUC__) && !defined(__clang__)
+# pragma GCC diagnostic pop
+#endif /* __GNUC__ */
+/* end __bulk_move() */
+} /* end lem */
+
+#endif /* LEMSTL_LEM_BULK_COPY_H_ */
@@ -0,0 +1,193 @@
+// Heap algorithms on random access ranges;
+#ifndef LEMSTL_LEM_HEAP_H_
+#define LEMSTL_LEM_HEAP_H_
+
+#include <cstddef> // for size_t;
+#include <utility> // for std::move();
+
+#include "../lem_iterator" // for iterator_traits;
+#include "../lem_functional" // for less;
+
+namespace lem {
+/* EM NOTE: d-ary heap */
+// Every heap algorithm takes the arity as its first template argument,
+// and the default one (Arity = 2) is the classic binary heap.
+// ##usage: lem::push_heap(vec.begin(), vec.end());
+// ##usage: lem::push_heap<4>(vec.begin(), vec.end());
+//
+// The children of node i are [Arity * i + 1, Arity * i + Arity],
+// and the parent of node i is (i - 1) / Arity.
+// A 4-ary heap is half as deep as a binary one, and the 4 children
+// of a node lie next to each other, which is friendlier to the cache
+// when the heap is stored in contiguous memory.
+//
+// EM NOTE: all the sifts here are hole-based.
+// The value being sifted is moved out of the range first,
+// and elements are moved into the hole one by one,
+// which costs 1 move per level instead of 3 for a swap().
+
+/* push_heap() */
+// sift value up from hole, but never above top;
+template <size_t Arity, typename RandomAccessIterator, typename DiffType, typename T, typename Comp>
+void __push_heap(RandomAccessIterator head, DiffType hole, DiffType top, T value, Comp islt) {
+  DiffType parent = (hole - 1) / DiffType(Arity);
+
+  while (hole > top && islt(*(head + parent), value)) {
+    *(head + hole) = ::std::move(*(head + parent));
+    hole = parent;
+    parent = (hole - 1) / DiffType(Arity);
+  }
+  *(head + hole) = ::std::move(value);
+
+  return;
+}
+// [head, tail - 1) is a heap, and *(tail - 1) is pushed into it;
+template <size_t Arity = 2, typename RandomAccessIterator, typename Comp>
+inline void push_heap(RandomAccessIterator head, RandomAccessIterator tail, Comp islt) {
+  static_assert(Arity >= 2, "Heap arity should be at least 2. ");
+  using diff_type = typename iterator_traits<RandomAccessIterator>::difference_type;
+  using value_type = typename iterator_traits<RandomAccessIterator>::value_type;
+
+  diff_type len = tail - head;
+  if (len < 2) {
+    return;
+  }
+
+  value_type value = ::std::move(*(tail - 1));
+  ::lem::__push_heap<Arity>(head, len - 1, diff_type(0), ::std::move(value), islt);
+
+  return;
+}
+template <size_t Arity = 2, typename RandomAccessIterator>
+inline void push_heap(RandomAccessIterator head, RandomAccessIterator tail) {
+  using value_type = typename iterator_traits<RandomAccessIterator>::value_type;
+  ::lem::push_heap<Arity>(head, tail, ::lem::less<value_type>());
+}
+/* end push_heap() */
+
+/* pop_heap() */
+// Fill the hole with value and restore the heap of length len.
+// EM NOTE: the hole is first moved down to a leaf along the greatest children,
+// and value is then sifted up from that leaf (Floyd's method).
+// value usually comes from the bottom of the heap and sinks back to the bottom,
+// so this saves most of the comparisons between value and children.
+template <size_t Arity, typename RandomAccessIterator, typename DiffType, typename T, typename Comp>
+void __adjust_heap(RandomAccessIterator head, DiffType hole, DiffType len, T value, Comp islt) {
+  DiffType top = hole;
+  DiffType child = DiffType(Arity) * hole + 1;
+
+  while (child < len) {
+    // find the greatest one among (at most Arity) children;
+    DiffType last = (len - child < DiffType(Arity) ? len : child + DiffType(Arity));
+    DiffType greatest = child;
+    for (++child; child < last; ++child) {
+      if (islt(*(head + greatest), *(head + child))) {
+        greatest = child;
+      }
+    }
+
+    // move the greatest child up into the hole;
+    *(head + hole) = ::std::move(*(head + greatest));
+    hole = greatest;
+    child = DiffType(Arity) * hole + 1;
+  }
+
+  // Now hole is a leaf;
+  ::lem::__push_heap<Arity>(head, hole, top, ::std::move(value), islt);
+
+  return;
+}
+// move the top of heap [head, tail) to tail - 1,
+// and [head, tail - 1) is still a heap;
+template <size_t Arity = 2, typename RandomAccessIterator, typename Comp>
+inline void pop_heap(RandomAccessIterator head, RandomAccessIterator tail, Comp islt) {
+  static_assert(Arity >= 2, "Heap arity should be at least 2. ");
+  using diff_type = typename iterator_traits<RandomAccessIterator>::difference_type;
+  using value_type = typename iterator_traits<RandomAccessIterator>::value_type;
+
+  diff_type len = tail - head;
+  if (len < 2) {
+    return;
+  }
+
+  value_type value = ::std::move(*(tail - 1));
+  *(tail - 1) = ::std::move(*head);
+  ::lem::__adjust_heap<Arity>(head, diff_type(0), len - 1, ::std::move(value), islt);
+
+  return;
+}
+template <size_t Arity = 2, typename RandomAccessIterator>
+inline void pop_heap(RandomAccessIterator head, RandomAccessIterator tail) {
+  using value_type = typename iterator_traits<RandomAccessIterator>::value_type;
+  ::lem::pop_heap<Arity>(head, tail, ::lem::less<value_type>());
+}
+/* end pop_heap() */
+
+/* make_heap() */
+template <size_t Arity = 2, typename RandomAccessIterator, typename Comp>
+void make_heap(RandomAccessIterator head, RandomAccessIterator tail, Comp islt) {
+  static_assert(Arity >= 2, "Heap arity should be at least 2. ");
+  using diff_type = typename iterator_traits<RandomAccessIterator>::difference_type;
+  using value_type = typename iterator_traits<RandomAccessIterator>::value_type;
+
+  diff_type len = tail - head;
+  if (len < 2) {
+    return;
+  }
+
+  // adjust every non-leaf node, from the last one to the root;
+  for (diff_type parent = (len - 2) / diff_type(Arity); parent >= 0; --parent) {
+    value_type value = ::std::move(*(head + parent));
+    ::lem::__adjust_heap<Arity>(head, parent, len, ::std::move(value), islt);
+  }
+
+  return;
+}
+template <size_t Arity = 2, typename RandomAccessIterator>
+inline void make_heap(RandomAccessIterator head, RandomAccessIterator tail) {
+  using value_type = typename iterator_traits<RandomAccessIterator>::value_type;
+  ::lem::make_heap<Arity>(head, tail, ::lem::less<value_type>());
+}
+/* end make_heap() */
+
+/* sort_heap() */
+// [head, tail) should already be a heap;
+template <size_t Arity = 2, typename RandomAccessIterator, typename Comp>
+void sort_heap(RandomAccessIterator head, RandomAccessIterator tail, Comp islt) {
+  for (; tail - head > 1; --tail) {
+    ::lem::pop_heap<Arity>(head, tail, islt);
+  }
+
+  return;
+}
+template <size_t Arity = 2, typename RandomAccessIterator>
+inline void sort_heap(RandomAccessIterator head, RandomAccessIterator tail) {
+  using value_type = typename iterator_traits<RandomAccessIterator>::value_type;
+  ::lem::sort_heap<Arity>(head, tail, ::lem::less<value_type>());
+}
+/* end sort_heap() */
+
+/* is_heap() */
+template <size_t Arity = 2, typename RandomAccessIterator, typename Comp>
+bool is_heap(RandomAccessIterator head, RandomAccessIterator tail, Comp islt) {
+  static_assert(Arity >= 2, "Heap arity should be at least 2. ");
+  using diff_type = typename iterator_traits<RandomAccessIterator>::difference_type;
+
+  diff_type len = tail - head;
+  for (diff_type child = 1; child < len; ++child) {
+    if (islt(*(head + (child - 1) / diff_type(Arity)), *(head + child))) {
+      return false;
+    }
+  }
+
+  return true;
+}
+template <size_t Arity = 2, typename RandomAccessIterator>
+inline bool is_heap(RandomAccessIterator head, RandomAccessIterator tail) {
+  using value_type = typename iterator_traits<RandomAccessIterator>::value_type;
+  return ::lem::is_heap<Arity>(head, tail, ::lem::less<value_type>());
+}
+/* end is_heap() */
+} /* end lem */
+
+#endif /* LEMSTL_LEM_HEAP_H_ */
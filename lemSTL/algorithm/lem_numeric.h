@@ -0,0 +1,727 @@
+// Numeric algorithms on ranges;
+#ifndef LEMSTL_LEM_NUMERIC_H_
+#define LEMSTL_LEM_NUMERIC_H_
+
+#include <cstddef> // for size_t;
+#include <utility> // for std::move();
+
+#include "../lem_iterator" // for iterator_traits;
+#include "../lem_type_traits" // for condition tags;
+#include "../lem_functional" // for plus, minus, multiplies and less;
+#include "../lem_utility" // for pair;
+#include "lem_simd.h" // for SIMD settings and __simd_traits;
+#include "lem_prefetch.h" // for __list_prefetch_walk();
+
+namespace lem {
+/* EM NOTE: SIMD kernels */
+// A plain `for (...) sum += *head;` is a chain of dependent additions,
+// and the compiler may not reorder floating point additions to break it.
+// The kernels below sum into several independent accumulators,
+// which keeps the pipeline (or the vector lanes) busy,
+// and combine the accumulators at the end.
+//
+// Kernels are only used for contiguous iterators over int, unsigned int, float and double,
+// see __simd_traits in lem_simd.h for which algorithm may use which kernel.
+
+/* fallback kernels */
+template <typename T>
+T __kernel_sum(T const* head, size_t n) {
+  T acc0 = T(), acc1 = T(), acc2 = T(), acc3 = T();
+  size_t ind = 0;
+
+  for (; ind + 4 <= n; ind += 4) {
+    acc0 += head[ind];
+    acc1 += head[ind + 1];
+    acc2 += head[ind + 2];
+    acc3 += head[ind + 3];
+  }
+  for (; ind < n; ++ind) {
+    acc0 += head[ind];
+  }
+
+  return (acc0 + acc1) + (acc2 + acc3);
+}
+template <typename T>
+T __kernel_dot(T const* head1, T const* head2, size_t n) {
+  T acc0 = T(), acc1 = T(), acc2 = T(), acc3 = T();
+  size_t ind = 0;
+
+  for (; ind + 4 <= n; ind += 4) {
+    acc0 += head1[ind] * head2[ind];
+    acc1 += head1[ind + 1] * head2[ind + 1];
+    acc2 += head1[ind + 2] * head2[ind + 2];
+    acc3 += head1[ind + 3] * head2[ind + 3];
+  }
+  for (; ind < n; ++ind) {
+    acc0 += head1[ind] * head2[ind];
+  }
+
+  return (acc0 + acc1) + (acc2 + acc3);
+}
+// n should be positive;
+template <typename T>
+T __kernel_min(T const* head, size_t n) {
+  T result = head[0];
+  for (size_t ind = 1; ind < n; ++ind) {
+    result = (head[ind] < result ? head[ind] : result);
+  }
+
+  return result;
+}
+template <typename T>
+T __kernel_max(T const* head, size_t n) {
+  T result = head[0];
+  for (size_t ind = 1; ind < n; ++ind) {
+    result = (result < head[ind] ? head[ind] : result);
+  }
+
+  return result;
+}
+/* end fallback kernels */
+
+#ifdef LEM_SIMD_AVX2
+/* AVX2 kernels */
+// 4 vector accumulators, i.e. 32 floats or 16 doubles per round;
+inline unsigned int __kernel_sum(unsigned int const* head, size_t n) {
+  __m256i acc0 = _mm256_setzero_si256();
+  __m256i acc1 = _mm256_setzero_si256();
+  __m256i acc2 = _mm256_setzero_si256();
+  __m256i acc3 = _mm256_setzero_si256();
+  size_t ind = 0;
+
+  for (; ind + 32 <= n; ind += 32) {
+    acc0 = _mm256_add_epi32(acc0, _mm256_loadu_si256((__m256i const*)(head + ind)));
+    acc1 = _mm256_add_epi32(acc1, _mm256_loadu_si256((__m256i const*)(head + ind + 8)));
+    acc2 = _mm256_add_epi32(acc2, _mm256_loadu_si256((__m256i const*)(head + ind + 16)));
+    acc3 = _mm256_add_epi32(acc3, _mm256_loadu_si256((__m256i const*)(head + ind + 24)));
+  }
+  for (; ind + 8 <= n; ind += 8) {
+    acc0 = _mm256_add_epi32(acc0, _mm256_loadu_si256((__m256i const*)(head + ind)));
+  }
+  acc0 = _mm256_add_epi32(_mm256_add_epi32(acc0, acc1), _mm256_add_epi32(acc2, acc3));
+
+  // horizontal sum;
+  alignas(32) unsigned int lanes[8];
+  _mm256_store_si256((__m256i*)lanes, acc0);
+  unsigned int result = 0;
+  for (size_t lane = 0; lane < 8; ++lane) {
+    result += lanes[lane];
+  }
+  for (; ind < n; ++ind) {
+    result += head[ind];
+  }
+
+  return result;
+}
+inline float __kernel_sum(float const* head, size_t n) {
+  __m256 acc0 = _mm256_setzero_ps();
+  __m256 acc1 = _mm256_setzero_ps();
+  __m256 acc2 = _mm256_setzero_ps();
+  __m256 acc3 = _mm256_setzero_ps();
+  size_t ind = 0;
+
+  for (; ind + 32 <= n; ind += 32) {
+    acc0 = _mm256_add_ps(acc0, _mm256_loadu_ps(head + ind));
+    acc1 = _mm256_add_ps(acc1, _mm256_loadu_ps(head + ind + 8));
+    acc2 = _mm256_add_ps(acc2, _mm256_loadu_ps(head + ind + 16));
+    acc3 = _mm256_add_ps(acc3, _mm256_loadu_ps(head + ind + 24));
+  }
+  for (; ind + 8 <= n; ind += 8) {
+    acc0 = _mm256_add_ps(acc0, _mm256_loadu_ps(head + ind));
+  }
+  acc0 = _mm256_add_ps(_mm256_add_ps(acc0, acc1), _mm256_add_ps(acc2, acc3));
+
+  // horizontal sum;
+  alignas(32) float lanes[8];
+  _mm256_store_ps(lanes, acc0);
+  float result = ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+  for (; ind < n; ++ind) {
+    result += head[ind];
+  }
+
+  return result;
+}
+inline double __kernel_sum(double const* head, size_t n) {
+  __m256d acc0 = _mm256_setzero_pd();
+  __m256d acc1 = _mm256_setzero_pd();
+  __m256d acc2 = _mm256_setzero_pd();
+  __m256d acc3 = _mm256_setzero_pd();
+  size_t ind = 0;
+
+  for (; ind + 16 <= n; ind += 16) {
+    acc0 = _mm256_add_pd(acc0, _mm256_loadu_pd(head + ind));
+    acc1 = _mm256_add_pd(acc1, _mm256_loadu_pd(head + ind + 4));
+    acc2 = _mm256_add_pd(acc2, _mm256_loadu_pd(head + ind + 8));
+    acc3 = _mm256_add_pd(acc3, _mm256_loadu_pd(head + ind + 12));
+  }
+  for (; ind + 4 <= n; ind += 4) {
+    acc0 = _mm256_add_pd(acc0, _mm256_loadu_pd(head + ind));
+  }
+  acc0 = _mm256_add_pd(_mm256_add_pd(acc0, acc1), _mm256_add_pd(acc2, acc3));
+
+  // horizontal sum;
+  alignas(32) double lanes[4];
+  _mm256_store_pd(lanes, acc0);
+  double result = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+  for (; ind < n; ++ind) {
+    result += head[ind];
+  }
+
+  return result;
+}
+
+inline unsigned int __kernel_dot(unsigned int const* head1, unsigned int const* head2, size_t n) {
+  __m256i acc0 = _mm256_setzero_si256();
+  __m256i acc1 = _mm256_setzero_si256();
+  size_t ind = 0;
+
+  for (; ind + 16 <= n; ind += 16) {
+    acc0 = _mm256_add_epi32(acc0, _mm256_mullo_epi32(_mm256_loadu_si256((__m256i const*)(head1 + ind)),
+                                                     _mm256_loadu_si256((__m256i const*)(head2 + ind))));
+    acc1 = _mm256_add_epi32(acc1, _mm256_mullo_epi32(_mm256_loadu_si256((__m256i const*)(head1 + ind + 8)),
+                                                     _mm256_loadu_si256((__m256i const*)(head2 + ind + 8))));
+  }
+  acc0 = _mm256_add_epi32(acc0, acc1);
+
+  // horizontal sum;
+  alignas(32) unsigned int lanes[8];
+  _mm256_store_si256((__m256i*)lanes, acc0);
+  unsigned int result = 0;
+  for (size_t lane = 0; lane < 8; ++lane) {
+    result += lanes[lane];
+  }
+  for (; ind < n; ++ind) {
+    result += head1[ind] * head2[ind];
+  }
+
+  return result;
+}
+// EM NOTE: FMA is a separate extension; msvc never defines __FMA__,
+// in which case a multiplication and an addition are used.
+inline __m256 __avx2_madd(__m256 a, __m256 b, __m256 acc) {
+  #ifdef __FMA__
+    return _mm256_fmadd_ps(a, b, acc);
+  #else
+    return _mm256_add_ps(_mm256_mul_ps(a, b), acc);
+  #endif
+}
+inline __m256d __avx2_madd(__m256d a, __m256d b, __m256d acc) {
+  #ifdef __FMA__
+    return _mm256_fmadd_pd(a, b, acc);
+  #else
+    return _mm256_add_pd(_mm256_mul_pd(a, b), acc);
+  #endif
+}
+inline float __kernel_dot(float const* head1, float const* head2, size_t n) {
+  __m256 acc0 = _mm256_setzero_ps();
+  __m256 acc1 = _mm256_setzero_ps();
+  __m256 acc2 = _mm256_setzero_ps();
+  __m256 acc3 = _mm256_setzero_ps();
+  size_t ind = 0;
+
+  for (; ind + 32 <= n; ind += 32) {
+    acc0 = __avx2_madd(_mm256_loadu_ps(head1 + ind), _mm256_loadu_ps(head2 + ind), acc0);
+    acc1 = __avx2_madd(_mm256_loadu_ps(head1 + ind + 8), _mm256_loadu_ps(head2 + ind + 8), acc1);
+    acc2 = __avx2_madd(_mm256_loadu_ps(head1 + ind + 16), _mm256_loadu_ps(head2 + ind + 16), acc2);
+    acc3 = __avx2_madd(_mm256_loadu_ps(head1 + ind + 24), _mm256_loadu_ps(head2 + ind + 24), acc3);
+  }
+  for (; ind + 8 <= n; ind += 8) {
+    acc0 = __avx2_madd(_mm256_loadu_ps(head1 + ind), _mm256_loadu_ps(head2 + ind), acc0);
+  }
+  acc0 = _mm256_add_ps(_mm256_add_ps(acc0, acc1), _mm256_add_ps(acc2, acc3));
+
+  // horizontal sum;
+  alignas(32) float lanes[8];
+  _mm256_store_ps(lanes, acc0);
+  float result = ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+  for (; ind < n; ++ind) {
+    result += head1[ind] * head2[ind];
+  }
+
+  return result;
+}
+inline double __kernel_dot(double const* head1, double const* head2, size_t n) {
+  __m256d acc0 = _mm256_setzero_pd();
+  __m256d acc1 = _mm256_setzero_pd();
+  __m256d acc2 = _mm256_setzero_pd();
+  __m256d acc3 = _mm256_setzero_pd();
+  size_t ind = 0;
+
+  for (; ind + 16 <= n; ind += 16) {
+    acc0 = __avx2_madd(_mm256_loadu_pd(head1 + ind), _mm256_loadu_pd(head2 + ind), acc0);
+    acc1 = __avx2_madd(_mm256_loadu_pd(head1 + ind + 4), _mm256_loadu_pd(head2 + ind + 4), acc1);
+    acc2 = __avx2_madd(_mm256_loadu_pd(head1 + ind + 8), _mm256_loadu_pd(head2 + ind + 8), acc2);
+    acc3 = __avx2_madd(_mm256_loadu_pd(head1 + ind + 12), _mm256_loadu_pd(head2 + ind + 12), acc3);
+  }
+  for (; ind + 4 <= n; ind += 4) {
+    acc0 = __avx2_madd(_mm256_loadu_pd(head1 + ind), _mm256_loadu_pd(head2 + ind), acc0);
+  }
+  acc0 = _mm256_add_pd(_mm256_add_pd(acc0, acc1), _mm256_add_pd(acc2, acc3));
+
+  // horizontal sum;
+  alignas(32) double lanes[4];
+  _mm256_store_pd(lanes, acc0);
+  double result = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+  for (; ind < n; ++ind) {
+    result += head1[ind] * head2[ind];
+  }
+
+  return result;
+}
+
+// lane-wise min and max of 32-bit integers;
+inline __m256i __avx2_min(__m256i a, __m256i b, int*) {
+  return _mm256_min_epi32(a, b);
+}
+inline __m256i __avx2_min(__m256i a, __m256i b, unsigned int*) {
+  return _mm256_min_epu32(a, b);
+}
+inline __m256i __avx2_max(__m256i a, __m256i b, int*) {
+  return _mm256_max_epi32(a, b);
+}
+inline __m256i __avx2_max(__m256i a, __m256i b, unsigned int*) {
+  return _mm256_max_epu32(a, b);
+}
+// n should be positive;
+template <typename T>
+T __avx2_kernel_min(T const* head, size_t n) {
+  T result = head[0];
+  size_t ind = 0;
+
+  if (n >= 8) {
+    __m256i acc = _mm256_loadu_si256((__m256i const*)head);
+    for (ind = 8; ind + 8 <= n; ind += 8) {
+      acc = ::lem::__avx2_min(acc, _mm256_loadu_si256((__m256i const*)(head + ind)), (T*)nullptr);
+    }
+
+    alignas(32) T lanes[8];
+    _mm256_store_si256((__m256i*)lanes, acc);
+    result = ::lem::__kernel_min(lanes, 8);
+  }
+  for (; ind < n; ++ind) {
+    result = (head[ind] < result ? head[ind] : result);
+  }
+
+  return result;
+}
+template <typename T>
+T __avx2_kernel_max(T const* head, size_t n) {
+  T result = head[0];
+  size_t ind = 0;
+
+  if (n >= 8) {
+    __m256i acc = _mm256_loadu_si256((__m256i const*)head);
+    for (ind = 8; ind + 8 <= n; ind += 8) {
+      acc = ::lem::__avx2_max(acc, _mm256_loadu_si256((__m256i const*)(head + ind)), (T*)nullptr);
+    }
+
+    alignas(32) T lanes[8];
+    _mm256_store_si256((__m256i*)lanes, acc);
+    result = ::lem::__kernel_max(lanes, 8);
+  }
+  for (; ind < n; ++ind) {
+    result = (result < head[ind] ? head[ind] : result);
+  }
+
+  return result;
+}
+inline int __kernel_min(int const* head, size_t n) {
+  return ::lem::__avx2_kernel_min(head, n);
+}
+inline unsigned int __kernel_min(unsigned int const* head, size_t n) {
+  return ::lem::__avx2_kernel_min(head, n);
+}
+inline int __kernel_max(int const* head, size_t n) {
+  return ::lem::__avx2_kernel_max(head, n);
+}
+inline unsigned int __kernel_max(unsigned int const* head, size_t n) {
+  return ::lem::__avx2_kernel_max(head, n);
+}
+/* end AVX2 kernels */
+#endif /* LEM_SIMD_AVX2 */
+
+// EM NOTE: signed integers are summed as unsigned ones,
+// which wraps around instead of overflowing (undefined behaviour).
+inline int __kernel_sum(int const* head, size_t n) {
+  return int(::lem::__kernel_sum(reinterpret_cast<unsigned int const*>(head), n));
+}
+inline int __kernel_dot(int const* head1, int const* head2, size_t n) {
+  return int(::lem::__kernel_dot(reinterpret_cast<unsigned int const*>(head1),
+                                 reinterpret_cast<unsigned int const*>(head2), n));
+}
+/* end SIMD kernels */
+
+/* accumulate() */
+// EM NOTE: accumulate() sums strictly from left to right,
+// so only the exact (integer) kernels are used here.
+// Use reduce() to sum floating point numbers with SIMD kernels.
+template <typename InputIterator, typename T, typename BinaryOp>
+T accumulate(InputIterator head, InputIterator tail, T init, BinaryOp op) {
+  for (; head != tail; ++head) {
+    init = op(init, *head);
+  }
+
+  return init;
+}
+// list nodes are walked with software prefetch;
+template <typename DataType, typename PointerType, typename ReferenceType, typename T, typename BinaryOp>
+T accumulate(__list_iterator<DataType, PointerType, ReferenceType> head,
+             __list_iterator<DataType, PointerType, ReferenceType> tail, T init, BinaryOp op) {
+  auto visit = [&init, &op](ReferenceType data) {
+    init = op(init, data);
+    return false;
+  };
+  ::lem::__list_prefetch_walk(head, tail, visit);
+
+  return init;
+}
+template <typename InputIterator, typename T>
+inline T __accumulate(InputIterator head, InputIterator tail, T init, ::lem::__false_tag) {
+  return ::lem::accumulate(head, tail, init, ::lem::plus<T>());
+}
+template <typename T>
+inline T __accumulate(T const* head, T const* tail, T init, ::lem::__true_tag) {
+  return init + ::lem::__kernel_sum(head, tail - head);
+}
+template <typename ContiguousIterator, typename T>
+inline T __accumulate(ContiguousIterator head, ContiguousIterator tail, T init, ::lem::__true_tag) {
+  return ::lem::__accumulate(::lem::__simd_pointer<T>(head), ::lem::__simd_pointer<T>(tail), init, ::lem::__true_tag());
+}
+// segmented iterators are summed a segment at a time, each by the pointer kernels;
+template <typename InputIterator, typename T>
+inline T __accumulate_segmented(InputIterator head, InputIterator tail, T init, ::lem::__false_tag) {
+  using is_exact = typename __simd_dispatch<InputIterator, T>::is_exact;
+  return ::lem::__accumulate(head, tail, init, is_exact());
+}
+template <typename SegmentedIterator, typename T>
+inline T __accumulate_segmented(SegmentedIterator head, SegmentedIterator tail, T init, ::lem::__true_tag) {
+  using local_iterator = typename __segmented_iterator_traits<SegmentedIterator>::local_iterator;
+
+  auto visit = [&init](local_iterator local_head, local_iterator local_tail) {
+    init = ::lem::__accumulate_segmented(local_head, local_tail, init, ::lem::__false_tag());
+  };
+  ::lem::__for_each_segment(head, tail, visit);
+
+  return init;
+}
+template <typename InputIterator, typename T>
+inline T accumulate(InputIterator head, InputIterator tail, T init) {
+  return ::lem::__accumulate_segmented(head, tail, init, __is_segmented_iterator<InputIterator>());
+}
+/* end accumulate() */
+
+/* reduce() */
+// reduce() is accumulate() in any order,
+// so floating point results may differ from accumulate() by rounding.
+template <typename InputIterator, typename T, typename BinaryOp>
+inline T reduce(InputIterator head, InputIterator tail, T init, BinaryOp op) {
+  return ::lem::accumulate(head, tail, init, op);
+}
+template <typename InputIterator, typename T>
+inline T __reduce(InputIterator head, InputIterator tail, T init, ::lem::__false_tag) {
+  return ::lem::accumulate(head, tail, init, ::lem::plus<T>());
+}
+template <typename T>
+inline T __reduce(T const* head, T const* tail, T init, ::lem::__true_tag) {
+  return init + ::lem::__kernel_sum(head, tail - head);
+}
+template <typename ContiguousIterator, typename T>
+inline T __reduce(ContiguousIterator head, ContiguousIterator tail, T init, ::lem::__true_tag) {
+  return ::lem::__reduce(::lem::__simd_pointer<T>(head), ::lem::__simd_pointer<T>(tail), init, ::lem::__true_tag());
+}
+template <typename InputIterator, typename T>
+inline T __reduce_segmented(InputIterator head, InputIterator tail, T init, ::lem::__false_tag) {
+  using has_kernel = typename __simd_dispatch<InputIterator, T>::has_kernel;
+  return ::lem::__reduce(head, tail, init, has_kernel());
+}
+template <typename SegmentedIterator, typename T>
+inline T __reduce_segmented(SegmentedIterator head, SegmentedIterator tail, T init, ::lem::__true_tag) {
+  using local_iterator = typename __segmented_iterator_traits<SegmentedIterator>::local_iterator;
+
+  auto visit = [&init](local_iterator local_head, local_iterator local_tail) {
+    init = ::lem::__reduce_segmented(local_head, local_tail, init, ::lem::__false_tag());
+  };
+  ::lem::__for_each_segment(head, tail, visit);
+
+  return init;
+}
+template <typename InputIterator, typename T>
+inline T reduce(InputIterator head, InputIterator tail, T init) {
+  return ::lem::__reduce_segmented(head, tail, init, __is_segmented_iterator<InputIterator>());
+}
+template <typename InputIterator>
+inline typename iterator_traits<InputIterator>::value_type
+reduce(InputIterator head, InputIterator tail) {
+  using value_type = typename iterator_traits<InputIterator>::value_type;
+  return ::lem::reduce(head, tail, value_type());
+}
+/* end reduce() */
+
+/* inner_product() */
+// inner_product() is computed strictly from left to right,
+// so only the exact (integer) kernels are used here.
+// Use transform_reduce() to get SIMD kernels for floating point numbers.
+template <typename InputIterator1, typename InputIterator2, typename T, typename BinaryOp1, typename BinaryOp2>
+T inner_product(InputIterator1 head1, InputIterator1 tail1, InputIterator2 head2, T init, BinaryOp1 sum_op, BinaryOp2 prod_op) {
+  for (; head1 != tail1; ++head1, ++head2) {
+    init = sum_op(init, prod_op(*head1, *head2));
+  }
+
+  return init;
+}
+template <typename InputIterator1, typename InputIterator2, typename T>
+inline T __inner_product(InputIterator1 head1, InputIterator1 tail1, InputIterator2 head2, T init, ::lem::__false_tag) {
+  return ::lem::inner_product(head1, tail1, head2, init, ::lem::plus<T>(), ::lem::multiplies<T>());
+}
+template <typename T>
+inline T __inner_product(T const* head1, T const* tail1, T const* head2, T init, ::lem::__true_tag) {
+  return init + ::lem::__kernel_dot(head1, head2, tail1 - head1);
+}
+template <typename ContiguousIterator1, typename ContiguousIterator2, typename T>
+inline T __inner_product(ContiguousIterator1 head1, ContiguousIterator1 tail1, ContiguousIterator2 head2, T init, ::lem::__true_tag) {
+  return ::lem::__inner_product(::lem::__simd_pointer<T>(head1), ::lem::__simd_pointer<T>(tail1),
+                                ::lem::__simd_pointer<T>(head2), init, ::lem::__true_tag());
+}
+template <typename InputIterator1, typename InputIterator2, typename T>
+inline T inner_product(InputIterator1 head1, InputIterator1 tail1, InputIterator2 head2, T init) {
+  using is_exact1 = typename __simd_dispatch<InputIterator1, T>::is_exact;
+  using is_exact2 = typename __simd_dispatch<InputIterator2, T>::is_exact;
+  return ::lem::__inner_product(head1, tail1, head2, init, ::lem::__tag_and(is_exact1(), is_exact2()));
+}
+/* end inner_product() */
+
+/* transform_reduce() */
+// inner_product() in any order;
+template <typename InputIterator1, typename InputIterator2, typename T, typename BinaryOp1, typename BinaryOp2>
+inline T transform_reduce(InputIterator1 head1, InputIterator1 tail1, InputIterator2 head2, T init, BinaryOp1 sum_op, BinaryOp2 prod_op) {
+  return ::lem::inner_product(head1, tail1, head2, init, sum_op, prod_op);
+}
+template <typename InputIterator1, typename InputIterator2, typename T>
+inline T __transform_reduce(InputIterator1 head1, InputIterator1 tail1, InputIterator2 head2, T init, ::lem::__false_tag) {
+  return ::lem::inner_product(head1, tail1, head2, init, ::lem::plus<T>(), ::lem::multiplies<T>());
+}
+template <typename T>
+inline T __transform_reduce(T const* head1, T const* tail1, T const* head2, T init, ::lem::__true_tag) {
+  return init + ::lem::__kernel_dot(head1, head2, tail1 - head1);
+}
+template <typename ContiguousIterator1, typename ContiguousIterator2, typename T>
+inline T __transform_reduce(ContiguousIterator1 head1, ContiguousIterator1 tail1, ContiguousIterator2 head2, T init, ::lem::__true_tag) {
+  return ::lem::__transform_reduce(::lem::__simd_pointer<T>(head1), ::lem::__simd_pointer<T>(tail1),
+                                   ::lem::__simd_pointer<T>(head2), init, ::lem::__true_tag());
+}
+template <typename InputIterator1, typename InputIterator2, typename T>
+inline T transform_reduce(InputIterator1 head1, InputIterator1 tail1, InputIterator2 head2, T init) {
+  using has_kernel1 = typename __simd_dispatch<InputIterator1, T>::has_kernel;
+  using has_kernel2 = typename __simd_dispatch<InputIterator2, T>::has_kernel;
+  return ::lem::__transform_reduce(head1, tail1, head2, init, ::lem::__tag_and(has_kernel1(), has_kernel2()));
+}
+/* end transform_reduce() */
+
+/* partial_sum() */
+// EM NOTE: every output depends on the previous one,
+// so partial_sum() and adjacent_difference() have no kernels.
+// The running value is kept in a local variable,
+// so that result may be the same as head.
+template <typename InputIterator, typename OutputIterator, typename BinaryOp>
+OutputIterator partial_sum(InputIterator head, InputIterator tail, OutputIterator result, BinaryOp op) {
+  if (head == tail) {
+    return result;
+  }
+
+  typename iterator_traits<InputIterator>::value_type sum = *head;
+  *result = sum;
+  while (++head != tail) {
+    sum = op(sum, *head);
+    *++result = sum;
+  }
+
+  return ++result;
+}
+template <typename InputIterator, typename OutputIterator>
+inline OutputIterator partial_sum(InputIterator head, InputIterator tail, OutputIterator result) {
+  using value_type = typename iterator_traits<InputIterator>::value_type;
+  return ::lem::partial_sum(head, tail, result, ::lem::plus<value_type>());
+}
+/* end partial_sum() */
+
+/* adjacent_difference() */
+template <typename InputIterator, typename OutputIterator, typename BinaryOp>
+OutputIterator adjacent_difference(InputIterator head, InputIterator tail, OutputIterator result, BinaryOp op) {
+  using value_type = typename iterator_traits<InputIterator>::value_type;
+
+  if (head == tail) {
+    return result;
+  }
+
+  value_type pred = *head;
+  *result = pred;
+  while (++head != tail) {
+    value_type cur = *head;
+    *++result = op(cur, pred);
+    pred = ::std::move(cur);
+  }
+
+  return ++result;
+}
+template <typename InputIterator, typename OutputIterator>
+inline OutputIterator adjacent_difference(InputIterator head, InputIterator tail, OutputIterator result) {
+  using value_type = typename iterator_traits<InputIterator>::value_type;
+  return ::lem::adjacent_difference(head, tail, result, ::lem::minus<value_type>());
+}
+/* end adjacent_difference() */
+
+/* min_element() & max_element() */
+// EM NOTE: with kernels, the extreme value is found first,
+// and a second scan returns its position.
+// Only the exact (integer) kernels are used here,
+// since the kernels would not agree with operator< on NaN.
+template <typename ForwardIterator, typename Comp>
+ForwardIterator min_element(ForwardIterator head, ForwardIterator tail, Comp islt) {
+  if (head == tail) {
+    return tail;
+  }
+
+  ForwardIterator result = head;
+  while (++head != tail) {
+    if (islt(*head, *result)) {
+      result = head;
+    }
+  }
+
+  return result;
+}
+template <typename ForwardIterator>
+inline ForwardIterator __min_element(ForwardIterator head, ForwardIterator tail, ::lem::__false_tag) {
+  using value_type = typename iterator_traits<ForwardIterator>::value_type;
+  return ::lem::min_element(head, tail, ::lem::less<value_type>());
+}
+template <typename T>
+T* __min_element(T* head, T* tail, ::lem::__true_tag) {
+  if (head == tail) {
+    return tail;
+  }
+
+  T value = ::lem::__kernel_min(head, tail - head);
+  while (*head != value) {
+    ++head;
+  }
+
+  return head;
+}
+template <typename ContiguousIterator>
+inline ContiguousIterator __min_element(ContiguousIterator head, ContiguousIterator tail, ::lem::__true_tag) {
+  auto first = ::lem::to_address(head);
+  return head + (::lem::__min_element(first, ::lem::to_address(tail), ::lem::__true_tag()) - first);
+}
+template <typename ForwardIterator>
+inline ForwardIterator min_element(ForwardIterator head, ForwardIterator tail) {
+  using value_type = typename iterator_traits<ForwardIterator>::value_type;
+  using is_exact = typename __simd_dispatch<ForwardIterator, value_type>::is_exact;
+  return ::lem::__min_element(head, tail, is_exact());
+}
+
+// returns the first greatest element;
+template <typename ForwardIterator, typename Comp>
+ForwardIterator max_element(ForwardIterator head, ForwardIterator tail, Comp islt) {
+  if (head == tail) {
+    return tail;
+  }
+
+  ForwardIterator result = head;
+  while (++head != tail) {
+    if (islt(*result, *head)) {
+      result = head;
+    }
+  }
+
+  return result;
+}
+template <typename ForwardIterator>
+inline ForwardIterator __max_element(ForwardIterator head, ForwardIterator tail, ::lem::__false_tag) {
+  using value_type = typename iterator_traits<ForwardIterator>::value_type;
+  return ::lem::max_element(head, tail, ::lem::less<value_type>());
+}
+template <typename T>
+T* __max_element(T* head, T* tail, ::lem::__true_tag) {
+  if (head == tail) {
+    return tail;
+  }
+
+  T value = ::lem::__kernel_max(head, tail - head);
+  while (*head != value) {
+    ++head;
+  }
+
+  return head;
+}
+template <typename ContiguousIterator>
+inline ContiguousIterator __max_element(ContiguousIterator head, ContiguousIterator tail, ::lem::__true_tag) {
+  auto first = ::lem::to_address(head);
+  return head + (::lem::__max_element(first, ::lem::to_address(tail), ::lem::__true_tag()) - first);
+}
+template <typename ForwardIterator>
+inline ForwardIterator max_element(ForwardIterator head, ForwardIterator tail) {
+  using value_type = typename iterator_traits<ForwardIterator>::value_type;
+  using is_exact = typename __simd_dispatch<ForwardIterator, value_type>::is_exact;
+  return ::lem::__max_element(head, tail, is_exact());
+}
+/* end min_element() & max_element() */
+
+/* minmax_element() */
+// returns the first smallest and the LAST greatest element;
+template <typename ForwardIterator, typename Comp>
+pair<ForwardIterator, ForwardIterator> minmax_element(ForwardIterator head, ForwardIterator tail, Comp islt) {
+  pair<ForwardIterator, ForwardIterator> result(head, head);
+  if (head == tail) {
+    return result;
+  }
+
+  while (++head != tail) {
+    if (islt(*head, *result.first)) {
+      result.first = head;
+    }
+    else if (!islt(*head, *result.second)) {
+      result.second = head;
+    }
+  }
+
+  return result;
+}
+template <typename ForwardIterator>
+inline pair<ForwardIterator, ForwardIterator> __minmax_element(ForwardIterator head, ForwardIterator tail, ::lem::__false_tag) {
+  using value_type = typename iterator_traits<ForwardIterator>::value_type;
+  return ::lem::minmax_element(head, tail, ::lem::less<value_type>());
+}
+template <typename T>
+pair<T*, T*> __minmax_element(T* head, T* tail, ::lem::__true_tag) {
+  pair<T*, T*> result(head, tail);
+  if (head == tail) {
+    return result;
+  }
+
+  result.first = ::lem::__min_element(head, tail, ::lem::__true_tag());
+  T value = ::lem::__kernel_max(head, tail - head);
+  do {
+    --result.second;
+  } while (*result.second != value);
+
+  return result;
+}
+template <typename ContiguousIterator>
+inline pair<ContiguousIterator, ContiguousIterator>
+__minmax_element(ContiguousIterator head, ContiguousIterator tail, ::lem::__true_tag) {
+  auto first = ::lem::to_address(head);
+  auto native = ::lem::__minmax_element(first, ::lem::to_address(tail), ::lem::__true_tag());
+
+  return pair<ContiguousIterator, ContiguousIterator>(head + (native.first - first), head + (native.second - first));
+}
+template <typename ForwardIterator>
+inline pair<ForwardIterator, ForwardIterator> minmax_element(ForwardIterator head, ForwardIterator tail) {
+  using value_type = typename iterator_traits<ForwardIterator>::value_type;
+  using is_exact = typename __simd_dispatch<ForwardIterator, value_type>::is_exact;
+  return ::lem::__minmax_element(head, tail, is_exact());
+}
+/* end minmax_element() */
+} /* end lem */
+
+#endif /* LEMSTL_LEM_NUMERIC_H_ */
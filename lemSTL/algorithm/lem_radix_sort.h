@@ -0,0 +1,288 @@
+// LSD radix sort for integral and floating point keys;
+#ifndef LEMSTL_LEM_RADIX_SORT_H_
+#define LEMSTL_LEM_RADIX_SORT_H_
+
+#include <cstddef> // for size_t;
+#include <cstdint> // for uint32_t and uint64_t;
+#include <cstring> // for memcpy();
+#include <type_traits> // for std::decay, std::conditional and std::make_unsigned;
+#include <utility> // for std::move();
+#include <exception> // for std::exception;
+
+#include "../lem_type_traits" // for __type_traits;
+// EM NOTE: lem_memory is not included here,
+// since lem_uninitialized.h includes lem_algorithm, and vice versa.
+#include "../allocator/lem_alloc.h" // for simple_alloc;
+#include "../allocator/lem_construct.h" // for construct() and destroy();
+#include "lem_algobase.h" // for copy();
+#include "lem_algo.h" // for __insertion_sort();
+#include "lem_prefetch.h" // for __prefetch();
+
+namespace lem {
+template <typename DataType, typename AllocType, typename GrowthPolicy>
+class vector;
+
+/* radix key traits */
+// Map a key to an unsigned integer of the same size,
+// so that comparing the unsigned integers gives the order of the keys.
+template <typename KeyType>
+struct __radix_key_traits {};
+
+template <typename UnsignedType>
+struct __radix_unsigned_key {
+  using unsigned_type = UnsignedType;
+
+  static unsigned_type encode(UnsignedType key) {
+    return key;
+  }
+};
+// flip the sign bit, so that negative numbers go before positive ones;
+template <typename SignedType, typename UnsignedType>
+struct __radix_signed_key {
+  using unsigned_type = UnsignedType;
+
+  static unsigned_type encode(SignedType key) {
+    return unsigned_type(key) ^ (unsigned_type(1) << (sizeof(unsigned_type) * 8 - 1));
+  }
+};
+// EM NOTE: IEEE 754 floating point numbers are sign-magnitude.
+// For positive numbers, flip the sign bit as for signed integers;
+// for negative numbers, flip all the bits, since a greater magnitude is a smaller number.
+// NaN with sign bit 0 (the common case) goes after +inf.
+template <typename FloatType, typename UnsignedType>
+struct __radix_float_key {
+  using unsigned_type = UnsignedType;
+
+  static unsigned_type encode(FloatType key) {
+    static_assert(sizeof(FloatType) == sizeof(UnsignedType), "Floating point type size mismatch. ");
+
+    unsigned_type bits = 0;
+    ::std::memcpy(&bits, &key, sizeof(bits));
+    unsigned_type sign = unsigned_type(1) << (sizeof(unsigned_type) * 8 - 1);
+
+    return (bits & sign) ? ~bits : (bits ^ sign);
+  }
+};
+
+// char and wchar_t are signed or not depending on the platform;
+template <typename CharType>
+struct __radix_char_key
+    : ::std::conditional<::std::is_signed<CharType>::value,
+                         __radix_signed_key<CharType, typename ::std::make_unsigned<CharType>::type>,
+                         __radix_unsigned_key<typename ::std::make_unsigned<CharType>::type>>::type {};
+
+/* Explicit specializations for c++ native types */
+template <>
+struct __radix_key_traits<bool> : __radix_unsigned_key<unsigned char> {};
+template <>
+struct __radix_key_traits<char> : __radix_char_key<char> {};
+template <>
+struct __radix_key_traits<wchar_t> : __radix_char_key<wchar_t> {};
+template <>
+struct __radix_key_traits<char16_t> : __radix_char_key<char16_t> {};
+template <>
+struct __radix_key_traits<char32_t> : __radix_char_key<char32_t> {};
+template <>
+struct __radix_key_traits<signed char> : __radix_signed_key<signed char, unsigned char> {};
+template <>
+struct __radix_key_traits<unsigned char> : __radix_unsigned_key<unsigned char> {};
+template <>
+struct __radix_key_traits<short> : __radix_signed_key<short, unsigned short> {};
+template <>
+struct __radix_key_traits<unsigned short> : __radix_unsigned_key<unsigned short> {};
+template <>
+struct __radix_key_traits<int> : __radix_signed_key<int, unsigned int> {};
+template <>
+struct __radix_key_traits<unsigned int> : __radix_unsigned_key<unsigned int> {};
+template <>
+struct __radix_key_traits<long> : __radix_signed_key<long, unsigned long> {};
+template <>
+struct __radix_key_traits<unsigned long> : __radix_unsigned_key<unsigned long> {};
+template <>
+struct __radix_key_traits<long long> : __radix_signed_key<long long, unsigned long long> {};
+template <>
+struct __radix_key_traits<unsigned long long> : __radix_unsigned_key<unsigned long long> {};
+template <>
+struct __radix_key_traits<float> : __radix_float_key<float, ::std::uint32_t> {};
+template <>
+struct __radix_key_traits<double> : __radix_float_key<double, ::std::uint64_t> {};
+/* end explicit */
+/* end radix key traits */
+
+/* key extractors */
+template <typename DataType>
+struct __radix_identity {
+  DataType const& operator()(DataType const& data) const {
+    return data;
+  }
+};
+// comparator for the small-input insertion sort, consistent with the radix order;
+template <typename KeyExtract>
+struct __radix_key_less {
+  KeyExtract key_;
+
+  explicit __radix_key_less(KeyExtract key) : key_(key) {}
+
+  template <typename DataType>
+  bool operator()(DataType const& a, DataType const& b) const {
+    using key_type = typename ::std::decay<decltype(key_(a))>::type;
+    using traits = __radix_key_traits<key_type>;
+
+    return traits::encode(key_(a)) < traits::encode(key_(b));
+  }
+};
+/* end key extractors */
+
+/* radix_sort() */
+// EM NOTE: LSD radix sort with 8-bit digits.
+// 1. The histograms of ALL the digits are counted in one single pass,
+//    so the input is read (sizeof(key) + 1) times instead of 2 * sizeof(key) times.
+// 2. A digit is skipped if all the keys share the same value on it,
+//    e.g. the high bytes of small integers.
+// 3. Each pass scatters elements between [head, tail) and buffer (ping-pong),
+//    and the result is copied back only if it ends in buffer.
+// 4. The scatter writes to up to 256 places at once, which the hardware prefetcher
+//    does not follow, so the slot of the element __kRadixPrefetchDistance ahead
+//    is prefetched by the histogram offsets before it is written.
+// buffer must hold (tail - head) constructed or POD elements.
+
+constexpr size_t __kRadixBits = 8;
+constexpr size_t __kRadixBuckets = size_t(1) << __kRadixBits;
+// inputs shorter than this are sorted by __insertion_sort(), which is stable as well;
+// EM NOTE: insertion sort is quadratic, so the threshold stays small;
+constexpr size_t __kRadixSortThreshold = 64;
+constexpr size_t __kRadixPrefetchDistance = 16;
+
+template <typename DataType, typename KeyExtract>
+void __radix_sort_lsd(DataType* head, DataType* tail, DataType* buffer, KeyExtract key) {
+  using key_type = typename ::std::decay<decltype(key(*head))>::type;
+  using traits = __radix_key_traits<key_type>;
+  using unsigned_type = typename traits::unsigned_type;
+  constexpr size_t kPasses = sizeof(unsigned_type) * 8 / __kRadixBits;
+
+  size_t len = tail - head;
+
+  // count all the histograms in one pass;
+  size_t count[kPasses][__kRadixBuckets] = {};
+  for (DataType* cur = head; cur != tail; ++cur) {
+    unsigned_type bits = traits::encode(key(*cur));
+    for (size_t pass = 0; pass < kPasses; ++pass) {
+      ++count[pass][(bits >> (pass * __kRadixBits)) & (__kRadixBuckets - 1)];
+    }
+  }
+
+  DataType* from = head;
+  DataType* to = buffer;
+  for (size_t pass = 0; pass < kPasses; ++pass) {
+    size_t shift = pass * __kRadixBits;
+    size_t* bucket = count[pass];
+
+    // skip the digit shared by all keys;
+    if (bucket[(traits::encode(key(*from)) >> shift) & (__kRadixBuckets - 1)] == len) {
+      continue;
+    }
+
+    // turn counts into starting offsets;
+    size_t offset = 0;
+    for (size_t digit = 0; digit < __kRadixBuckets; ++digit) {
+      size_t num = bucket[digit];
+      bucket[digit] = offset;
+      offset += num;
+    }
+
+    // scatter (stable);
+    DataType* cur = from;
+    for (; size_t(from + len - cur) > __kRadixPrefetchDistance; ++cur) {
+      size_t ahead = (traits::encode(key(*(cur + __kRadixPrefetchDistance))) >> shift) & (__kRadixBuckets - 1);
+      ::lem::__prefetch(to + bucket[ahead]);
+      size_t digit = (traits::encode(key(*cur)) >> shift) & (__kRadixBuckets - 1);
+      to[bucket[digit]++] = ::std::move(*cur);
+    }
+    for (; cur != from + len; ++cur) {
+      size_t digit = (traits::encode(key(*cur)) >> shift) & (__kRadixBuckets - 1);
+      to[bucket[digit]++] = ::std::move(*cur);
+    }
+
+    DataType* cache = from;
+    from = to;
+    to = cache;
+  }
+
+  // if sorted data ends in buffer;
+  if (from != head) {
+    ::lem::copy(from, from + len, head);
+  }
+
+  return;
+}
+
+// POD elements need no construction in buffer;
+template <typename DataType, typename KeyExtract>
+inline void __radix_sort_aux(DataType* head, DataType* tail, DataType* buffer, KeyExtract key, ::lem::__true_tag) {
+  ::lem::__radix_sort_lsd(head, tail, buffer, key);
+}
+template <typename DataType, typename KeyExtract>
+void __radix_sort_aux(DataType* head, DataType* tail, DataType* buffer, KeyExtract key, ::lem::__false_tag) {
+  DataType* cur = buffer;
+  try {
+    for (DataType* mov = head; mov != tail; ++mov, ++cur) {
+      ::lem::construct(cur, *mov);
+    }
+    ::lem::__radix_sort_lsd(head, tail, buffer, key);
+  }
+  catch (::std::exception const& e) {
+    // commit or rollback semantics;
+    ::lem::destroy(buffer, cur);
+    throw e;
+  }
+
+  ::lem::destroy(buffer, cur);
+
+  return;
+}
+
+// ##usage: lem::radix_sort(vec.begin(), vec.end(), [](Record const& r) { return r.id; });
+// The key extractor should return an integral or floating point key.
+// radix_sort() is stable: elements with equal keys keep their order.
+template <typename AllocType = ::lem::alloc, typename DataType, typename KeyExtract>
+void radix_sort(DataType* head, DataType* tail, KeyExtract key) {
+  size_t len = tail - head;
+  if (len < __kRadixSortThreshold) {
+    ::lem::__insertion_sort(head, tail, ::lem::__radix_key_less<KeyExtract>(key));
+
+    return;
+  }
+
+  using buffer_allocator = ::lem::simple_alloc<DataType, AllocType>;
+  using is_POD = typename __type_traits<DataType>::is_POD_type;
+
+  DataType* buffer = buffer_allocator::allocate(len);
+  try {
+    ::lem::__radix_sort_aux(head, tail, buffer, key, is_POD());
+  }
+  catch (::std::exception const& e) {
+    // commit or rollback semantics;
+    buffer_allocator::deallocate(buffer, len);
+    throw e;
+  }
+  buffer_allocator::deallocate(buffer, len);
+
+  return;
+}
+template <typename AllocType = ::lem::alloc, typename DataType>
+inline void radix_sort(DataType* head, DataType* tail) {
+  ::lem::radix_sort<AllocType>(head, tail, ::lem::__radix_identity<DataType>());
+}
+// The scratch buffer comes from the allocator of vec;
+template <typename DataType, typename AllocType, typename GrowthPolicy, typename KeyExtract>
+inline void radix_sort(::lem::vector<DataType, AllocType, GrowthPolicy>& vec, KeyExtract key) {
+  ::lem::radix_sort<AllocType>(vec.begin(), vec.end(), key);
+}
+template <typename DataType, typename AllocType, typename GrowthPolicy>
+inline void radix_sort(::lem::vector<DataType, AllocType, GrowthPolicy>& vec) {
+  ::lem::radix_sort<AllocType>(vec.begin(), vec.end());
+}
+/* end radix_sort() */
+} /* end lem */
+
+#endif /* LEMSTL_LEM_RADIX_SORT_H_ */
@@ -0,0 +1,86 @@
+// SIMD configuration and kernel traits;
+#ifndef LEMSTL_LEM_SIMD_H_
+#define LEMSTL_LEM_SIMD_H_
+
+#include "../lem_type_traits" // for condition tags;
+#include "../lem_iterator" // for iterator_traits and to_address();
+
+/* SIMD settings */
+// EM NOTE: kernels are chosen at compile time, never at runtime.
+// Compile with AVX2 enabled (/arch:AVX2 for msvc, -mavx2 for gcc and clang)
+// to get the intrinsic kernels. Otherwise the kernels fall back to
+// plain loops with several independent accumulators, which compilers
+// are free to vectorize for the baseline instruction set.
+// Define LEM_SIMD_OFF to always use the fallback loops.
+#if defined(__AVX2__) && !defined(LEM_SIMD_OFF)
+# define LEM_SIMD_AVX2
+# include <immintrin.h>
+#endif /* LEM_SIMD */
+/* end SIMD settings */
+
+namespace lem {
+/* __simd_traits */
+// has_kernel: there are SIMD kernels (sum, dot product) for this type;
+// is_exact: the kernels give exactly the same result as a sequential loop.
+// EM NOTE: integer addition is associative (modulo 2^n) while floating point
+// addition is not, so only the algorithms allowed to reassociate (e.g. reduce())
+// may use the kernels of floating point types.
+template <typename T>
+struct __simd_traits {
+  using has_kernel = __false_tag;
+  using is_exact = __false_tag;
+};
+// const elements use the same kernels;
+template <typename T>
+struct __simd_traits<T const> : __simd_traits<T> {};
+/* Explicit specializations for c++ native types */
+template <>
+struct __simd_traits<int> {
+  using has_kernel = __true_tag;
+  using is_exact = __true_tag;
+};
+template <>
+struct __simd_traits<unsigned int> {
+  using has_kernel = __true_tag;
+  using is_exact = __true_tag;
+};
+template <>
+struct __simd_traits<float> {
+  using has_kernel = __true_tag;
+  using is_exact = __false_tag;
+};
+template <>
+struct __simd_traits<double> {
+  using has_kernel = __true_tag;
+  using is_exact = __false_tag;
+};
+/* end explicit */
+
+// Kernels only work on contiguous iterators (including native pointers)
+// over the result type T, since they read the range as contiguous memory.
+// The callers unwrap such iterators by __simd_pointer();
+template <typename ValueType, typename T>
+struct __simd_element {
+  using has_kernel = __false_tag;
+  using is_exact = __false_tag;
+};
+template <typename T>
+struct __simd_element<T, T> : __simd_traits<T> {};
+
+template <typename Iter, typename T, typename IsContiguous = typename __iterator_contiguity<Iter>::type>
+struct __simd_dispatch {
+  using has_kernel = __false_tag;
+  using is_exact = __false_tag;
+};
+template <typename Iter, typename T>
+struct __simd_dispatch<Iter, T, __true_tag>
+    : __simd_element<typename iterator_traits<Iter>::value_type, T> {};
+
+template <typename T, typename ContiguousIterator>
+inline T const* __simd_pointer(ContiguousIterator const& iter) {
+  return ::lem::to_address(iter);
+}
+/* end __simd_traits */
+} /* end lem */
+
+#endif /* LEMSTL_LEM_SIMD_H_ */
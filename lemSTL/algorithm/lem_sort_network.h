@@ -0,0 +1,156 @@
+// Sorting networks for small fixed-size ranges;
+#ifndef LEMSTL_LEM_SORT_NETWORK_H_
+#define LEMSTL_LEM_SORT_NETWORK_H_
+
+#include <cstddef> // for size_t;
+#include <utility> // for std::index_sequence;
+
+#include "../lem_iterator" // for iterator_traits;
+#include "../lem_functional" // for less;
+#include "lem_algobase.h" // for min() and max();
+
+namespace lem {
+/* EM NOTE: sorting networks */
+// A sorting network is a fixed sequence of compare-exchange operations,
+// which sorts any input of its size. The sequence does not depend on the data,
+// so there is no branch to mispredict: every compare-exchange
+// is a min() and a max(), which compile to conditional moves for native types.
+//
+// The networks are Batcher's merge exchange (Knuth, TAOCP vol. 3, 5.2.2, algorithm M),
+// which works for any n. The k-th comparator is computed by a constexpr function
+// and passed as a template argument, so each network unrolls to straight-line code
+// at compile time.
+constexpr size_t __kSortNetworkMax = 32;
+
+// number of comparators of the network on n elements;
+constexpr size_t __network_size(size_t n) {
+  if (n < 2) {
+    return 0;
+  }
+
+  size_t t = 0;
+  while ((size_t(1) << t) < n) {
+    ++t;
+  }
+
+  size_t count = 0;
+  for (size_t p = size_t(1) << (t - 1); p > 0; p >>= 1) {
+    size_t q = size_t(1) << (t - 1);
+    size_t r = 0;
+    size_t d = p;
+    for (;;) {
+      for (size_t i = 0; i + d < n; ++i) {
+        if ((i & p) == r) {
+          ++count;
+        }
+      }
+      if (q == p) {
+        break;
+      }
+      d = q - p;
+      q >>= 1;
+      r = p;
+    }
+  }
+
+  return count;
+}
+// the k-th comparator of the network on n elements, encoded as i * 64 + j (i < j);
+constexpr size_t __network_comparator(size_t n, size_t k) {
+  size_t t = 0;
+  while ((size_t(1) << t) < n) {
+    ++t;
+  }
+
+  size_t count = 0;
+  for (size_t p = size_t(1) << (t - 1); p > 0; p >>= 1) {
+    size_t q = size_t(1) << (t - 1);
+    size_t r = 0;
+    size_t d = p;
+    for (;;) {
+      for (size_t i = 0; i + d < n; ++i) {
+        if ((i & p) == r) {
+          if (count == k) {
+            return i * 64 + (i + d);
+          }
+          ++count;
+        }
+      }
+      if (q == p) {
+        break;
+      }
+      d = q - p;
+      q >>= 1;
+      r = p;
+    }
+  }
+
+  return 0;
+}
+
+template <size_t N, size_t K>
+struct __network_comparator_at {
+  static constexpr size_t kPair = ::lem::__network_comparator(N, K);
+  static constexpr size_t kFirst = kPair / 64;
+  static constexpr size_t kSecond = kPair % 64;
+};
+
+// branchless, with the smaller one in a;
+template <typename T, typename Comp>
+inline void __compare_exchange(T& a, T& b, Comp islt) {
+  T low = ::lem::min(a, b, islt);
+  b = ::lem::max(a, b, islt);
+  a = low;
+
+  return;
+}
+
+template <size_t N, typename RandomAccessIterator, typename Comp, size_t... K>
+inline void __apply_network(RandomAccessIterator head, Comp islt, ::std::index_sequence<K...>) {
+  // EM NOTE: elements of a braced list are evaluated in order;
+  int expand[] = { 0, (::lem::__compare_exchange(*(head + __network_comparator_at<N, K>::kFirst),
+                                                 *(head + __network_comparator_at<N, K>::kSecond),
+                                                 islt), 0)... };
+  (void)expand;
+  // the network for N <= 1 is empty;
+  (void)head;
+  (void)islt;
+
+  return;
+}
+
+// Sort the N elements starting at head.
+// sort_network() is not stable;
+// ##usage: lem::sort_network<8>(candidates.begin(), lem::greater<float>()); // top-8;
+template <size_t N, typename RandomAccessIterator, typename Comp>
+inline void sort_network(RandomAccessIterator head, Comp islt) {
+  static_assert(N <= __kSortNetworkMax, "Sorting networks are generated for at most 32 elements. ");
+
+  ::lem::__apply_network<N>(head, islt, ::std::make_index_sequence<::lem::__network_size(N)>());
+}
+template <size_t N, typename RandomAccessIterator>
+inline void sort_network(RandomAccessIterator head) {
+  using value_type = typename iterator_traits<RandomAccessIterator>::value_type;
+  ::lem::sort_network<N>(head, ::lem::less<value_type>());
+}
+
+// Sort n <= Max elements, choosing the network at runtime;
+template <typename RandomAccessIterator, typename Comp, size_t... N>
+inline void __sort_network_dispatch(RandomAccessIterator head, size_t n, Comp islt, ::std::index_sequence<N...>) {
+  using network_type = void (*)(RandomAccessIterator, Comp);
+  static network_type const table[] = { &::lem::sort_network<N, RandomAccessIterator, Comp>... };
+
+  table[n](head, islt);
+
+  return;
+}
+template <size_t Max, typename RandomAccessIterator, typename Comp>
+inline void __sort_network(RandomAccessIterator head, RandomAccessIterator tail, Comp islt) {
+  static_assert(Max <= __kSortNetworkMax, "Sorting networks are generated for at most 32 elements. ");
+
+  ::lem::__sort_network_dispatch(head, size_t(tail - head), islt, ::std::make_index_sequence<Max + 1>());
+}
+/* end sorting networks */
+} /* end lem */
+
+#endif /* LEMSTL_LEM_SORT_NETWORK_H_ */
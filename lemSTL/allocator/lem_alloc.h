@@ -7,7 +7,6 @@
 
 #include "../lem_exception" // for lem::alloc_zero_free_list;
 
-namespace lem {
 /* _THROW_BAD_ALLOC settings */
 // EM NOTE: we never use ::operator new here, 
 // because we are separating allocation with construction.
@@ -19,6 +18,7 @@ namespace lem {
 # define _THROW_BAD_ALLOC ::std::cout << "AllocationFailure: out of memory. " << ::std::endl; ::std::exit(EXIT_FAILURE)
 #endif /* _THROW_BAD_ALLOC */
 
+namespace lem {
 /* malloc()-based allocator, usually slower than the free-list-based one */
 // This allocator is thread-safe in most cases,
 // and is usually more efficient in space utilization.
@@ -63,6 +63,22 @@ class __malloc_alloc_template {
     return result;
   }
 
+  // bytes that an allocation of n bytes actually occupies;
+  // EM NOTE: malloc() hands out 16-byte granules, and large blocks
+  // are mapped by whole pages, so the rest of the granule or page
+  // is usable by the caller for free.
+  static size_t good_size(size_t n) {
+    constexpr size_t kGranule = 16;
+    constexpr size_t kPage = 4096;
+    constexpr size_t kMapThreshold = 16 * kPage;
+
+    if (n >= kMapThreshold) {
+      return (n + kPage - 1) & ~(kPage - 1);
+    }
+
+    return (n + kGranule - 1) & ~(kGranule - 1);
+  }
+
   // to customize oom handler;
   static void (*set_malloc_handler(void (*new_malloc_handler)()))(){
     void (*prev_malloc_handler)() = __malloc_alloc_oom_handler;
@@ -241,6 +257,12 @@ class __default_alloc_template {
   static void* allocate(size_t n);
   static void deallocate(void* p, size_t n);
   static void* reallocate(void* p, size_t prev_size, size_t new_size);
+
+  // bytes that an allocation of n bytes actually occupies,
+  // i.e. the free-list node size, or what malloc() gives for large blocks;
+  static size_t good_size(size_t n) {
+    return (n > __kMaxBytes ? malloc_alloc::good_size(n) : round_up(n));
+  }
 };
 
 template <bool threads, int inst>
@@ -452,6 +474,22 @@ class simple_alloc {
 
     return;
   }
+
+  // Number of Ts which fit in the memory given for a request of n Ts,
+  // which is n for allocators without good_size();
+  static size_t good_size(size_t n) {
+    return good_size_aux<Alloc>(n, 0);
+  }
+
+ private:
+  template <typename A>
+  static auto good_size_aux(size_t n, int) -> decltype(A::good_size(n)) {
+    return (n == 0 ? 0 : A::good_size(n * sizeof(T)) / sizeof(T));
+  }
+  template <typename A>
+  static size_t good_size_aux(size_t n, long) {
+    return n;
+  }
 };
 } /* end lem */
 #endif
@@ -13,6 +13,12 @@ inline void construct(AllocedObject* p, ValueType const& value) {
   new(p) AllocedObject(value); // placement new, call ctor AllocedObject(value);
 }
 
+// default-initialization, which leaves objects of trivial types uninitialized;
+template <typename AllocedObject>
+inline void default_construct(AllocedObject* p) {
+  new(p) AllocedObject; // no () here, or trivial types would be zeroed;
+}
+
 /* Destroy a specific object */
 // EM NOTE: you CAN destroy an object pointer that has ALREADY been destroyed.
 // This will not throw exceptions, because destroy() just destroy data
@@ -26,7 +32,7 @@ inline void destroy(Object* p) {
 /* Destroy objects in a specific range */
 template <typename ForwardIterator>
 inline void __destroy_aux(ForwardIterator head, ForwardIterator tail, ::lem::__false_tag) {
-  for (; head < tail; ++head) {
+  for (; head != tail; ++head) {
     ::lem::destroy(&*head);
   }
 }
@@ -136,7 +136,7 @@ ForwardIterator __uninitialized_copy_aux(InputIterator head, InputIterator tail,
   return cur;
 }
 template <typename InputIterator, typename ForwardIterator, typename ValueType>
-inline ForwardIterator __uninitialized_copy(InputIterator head, InputIterator tail, ForwardIterator result, const ValueType&) {
+inline ForwardIterator __uninitialized_copy(InputIterator head, InputIterator tail, ForwardIterator result, ValueType*) {
   using is_POD = typename __type_traits<ValueType>::is_POD_type;
   return ::lem::__uninitialized_copy_aux(head, tail, result, is_POD());
 }
@@ -0,0 +1,653 @@
+// Bit-packed vector<bool>;
+#ifndef LEMSTL_LEM_BVECTOR_H_
+#define LEMSTL_LEM_BVECTOR_H_
+
+#include <cstddef> // for size_t and ptrdiff_t;
+#include <cstdint> // for uint64_t;
+#include <cstring> // for memset() and memcpy();
+#include <initializer_list> // for std::initializer_list
+#if defined(_MSC_VER) && defined(_M_X64)
+  #include <intrin.h> // for __popcnt64() and _BitScanForward64();
+#endif
+
+#include "lem_vector.h"
+
+namespace lem {
+/* EM NOTE: bit-packed vector<bool> */
+// vector<bool> keeps 64 elements per word, so it takes 8 times less memory
+// than a byte per element, and fill(), count() and find() work a word at a time.
+// Elements are no longer addressable: the reference is a proxy (__bit_reference)
+// holding the word and the mask of the bit, and the iterator is the word
+// and the offset of the bit in it.
+//
+// The bits of the words beyond size() are always 0,
+// so whole words can be counted and searched without masking the last one.
+using __bit_word = ::std::uint64_t;
+constexpr size_t __kWordBits = 64;
+
+/* word operations */
+inline unsigned __popcount64(__bit_word word) {
+#if defined(__GNUC__) || defined(__clang__)
+  return unsigned(__builtin_popcountll(word));
+#elif defined(_MSC_VER) && defined(_M_X64)
+  return unsigned(__popcnt64(word));
+#else
+  word = word - ((word >> 1) & 0x5555555555555555ull);
+  word = (word & 0x3333333333333333ull) + ((word >> 2) & 0x3333333333333333ull);
+  word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+  return unsigned((word * 0x0101010101010101ull) >> 56);
+#endif
+}
+// index of the lowest set bit, word should not be 0;
+inline unsigned __count_trailing_zeros64(__bit_word word) {
+#if defined(__GNUC__) || defined(__clang__)
+  return unsigned(__builtin_ctzll(word));
+#elif defined(_MSC_VER) && defined(_M_X64)
+  unsigned long index = 0;
+  _BitScanForward64(&index, word);
+  return unsigned(index);
+#else
+  unsigned index = 0;
+  for (; (word & 1) == 0; word >>= 1) {
+    ++index;
+  }
+  return index;
+#endif
+}
+// bits [first, last) of a word, 0 <= first < last <= 64;
+inline __bit_word __bit_mask(unsigned first, unsigned last) {
+  return (~__bit_word(0) >> (__kWordBits - (last - first))) << first;
+}
+/* end word operations */
+
+/* __bit_reference */
+struct __bit_reference {
+  __bit_word* word_;
+  __bit_word mask_;
+
+  __bit_reference(__bit_word* word, __bit_word mask) : word_(word), mask_(mask) {}
+
+  operator bool(void) const noexcept {
+    return (*word_ & mask_) != 0;
+  }
+  __bit_reference& operator=(bool value) noexcept {
+    if (value) {
+      *word_ |= mask_;
+    }
+    else {
+      *word_ &= ~mask_;
+    }
+    return *this;
+  }
+  // assign the value, not the reference;
+  __bit_reference& operator=(__bit_reference const& other) noexcept {
+    return *this = bool(other);
+  }
+  void flip(void) noexcept {
+    *word_ ^= mask_;
+  }
+};
+// the proxies are temporaries, so swap() takes them by value;
+inline void swap(__bit_reference a, __bit_reference b) noexcept {
+  bool cache = a;
+  a = b;
+  b = cache;
+}
+/* end __bit_reference */
+
+/* __bit_iterator */
+struct __bit_iterator {
+  using iterator_category     = ::lem::random_access_iterator_tag;
+  using value_type            = bool;
+  using difference_type       = ptrdiff_t;
+  using pointer_type          = void;
+  using reference_type        = __bit_reference;
+
+  using self                  = __bit_iterator;
+
+  __bit_word* word_;
+  unsigned offset_; // [0, 64);
+
+  // ctor;
+  __bit_iterator(void) : word_(nullptr), offset_(0) {}
+  __bit_iterator(__bit_word* word, unsigned offset) : word_(word), offset_(offset) {}
+
+  // dereference;
+  reference_type operator*(void) const {
+    return reference_type(word_, __bit_word(1) << offset_);
+  }
+
+  // incre and decre;
+  self& operator++(void) {
+    if (++offset_ == __kWordBits) {
+      offset_ = 0;
+      ++word_;
+    }
+    return *this;
+  }
+  self operator++(int) {
+    self cache = *this;
+    ++(*this);
+    return cache;
+  }
+  self& operator--(void) {
+    if (offset_-- == 0) {
+      offset_ = __kWordBits - 1;
+      --word_;
+    }
+    return *this;
+  }
+  self operator--(int) {
+    self cache = *this;
+    --(*this);
+    return cache;
+  }
+
+  // random access;
+  self& operator+=(difference_type n) {
+    difference_type bit = n + difference_type(offset_);
+    // round towards minus infinity for negative bit;
+    difference_type word_offset = (bit >= 0 ? bit / difference_type(__kWordBits) :
+                                              -((-bit - 1) / difference_type(__kWordBits) + 1));
+    word_ += word_offset;
+    offset_ = unsigned(bit - word_offset * difference_type(__kWordBits));
+
+    return *this;
+  }
+  self& operator-=(difference_type n) {
+    return operator+=(-n);
+  }
+  self operator+(difference_type n) const {
+    self cache = *this;
+    return cache += n;
+  }
+  self operator-(difference_type n) const {
+    self cache = *this;
+    return cache -= n;
+  }
+  difference_type operator-(self const& other) const {
+    return (word_ - other.word_) * difference_type(__kWordBits) + difference_type(offset_) - difference_type(other.offset_);
+  }
+  reference_type operator[](difference_type n) const {
+    return *(*this + n);
+  }
+
+  // comparison;
+  bool operator==(self const& other) const {
+    return word_ == other.word_ && offset_ == other.offset_;
+  }
+  bool operator!=(self const& other) const {
+    return !(*this == other);
+  }
+  bool operator<(self const& other) const {
+    return word_ < other.word_ || (word_ == other.word_ && offset_ < other.offset_);
+  }
+  bool operator<=(self const& other) const {
+    return !(other < *this);
+  }
+  bool operator>(self const& other) const {
+    return other < *this;
+  }
+  bool operator>=(self const& other) const {
+    return !(*this < other);
+  }
+};
+/* end __bit_iterator */
+
+/* word-wide range operations */
+// EM NOTE: [head, tail) is split into the partial word at each end,
+// which is masked, and the whole words between them.
+// tail.word_ is never read if tail.offset_ == 0, since it may be the end of the storage.
+inline void __bit_fill(__bit_iterator head, __bit_iterator tail, bool value) {
+  __bit_word fill_word = (value ? ~__bit_word(0) : __bit_word(0));
+  if (head.word_ == tail.word_) {
+    if (head.offset_ != tail.offset_) {
+      __bit_word mask = ::lem::__bit_mask(head.offset_, tail.offset_);
+      *head.word_ = (*head.word_ & ~mask) | (fill_word & mask);
+    }
+    return;
+  }
+
+  if (head.offset_ != 0) {
+    __bit_word mask = ::lem::__bit_mask(head.offset_, __kWordBits);
+    *head.word_ = (*head.word_ & ~mask) | (fill_word & mask);
+    ++head.word_;
+  }
+  for (__bit_word* word = head.word_; word != tail.word_; ++word) {
+    *word = fill_word;
+  }
+  if (tail.offset_ != 0) {
+    __bit_word mask = ::lem::__bit_mask(0, tail.offset_);
+    *tail.word_ = (*tail.word_ & ~mask) | (fill_word & mask);
+  }
+
+  return;
+}
+// number of set bits;
+inline ptrdiff_t __bit_count(__bit_iterator head, __bit_iterator tail) {
+  if (head.word_ == tail.word_) {
+    return (head.offset_ == tail.offset_ ? 0 :
+            ::lem::__popcount64(*head.word_ & ::lem::__bit_mask(head.offset_, tail.offset_)));
+  }
+
+  ptrdiff_t count = 0;
+  if (head.offset_ != 0) {
+    count += ::lem::__popcount64(*head.word_ & ::lem::__bit_mask(head.offset_, __kWordBits));
+    ++head.word_;
+  }
+  for (__bit_word* word = head.word_; word != tail.word_; ++word) {
+    count += ::lem::__popcount64(*word);
+  }
+  if (tail.offset_ != 0) {
+    count += ::lem::__popcount64(*tail.word_ & ::lem::__bit_mask(0, tail.offset_));
+  }
+
+  return count;
+}
+// first bit equal to value, or tail;
+inline __bit_iterator __bit_find(__bit_iterator head, __bit_iterator tail, bool value) {
+  // the bits of value are the set bits of word ^ flip;
+  __bit_word flip = (value ? __bit_word(0) : ~__bit_word(0));
+  if (head.word_ == tail.word_) {
+    if (head.offset_ == tail.offset_) {
+      return tail;
+    }
+    __bit_word found = (*head.word_ ^ flip) & ::lem::__bit_mask(head.offset_, tail.offset_);
+    return (found == 0 ? tail : __bit_iterator(head.word_, ::lem::__count_trailing_zeros64(found)));
+  }
+
+  if (head.offset_ != 0) {
+    __bit_word found = (*head.word_ ^ flip) & ::lem::__bit_mask(head.offset_, __kWordBits);
+    if (found != 0) {
+      return __bit_iterator(head.word_, ::lem::__count_trailing_zeros64(found));
+    }
+    ++head.word_;
+  }
+  for (__bit_word* word = head.word_; word != tail.word_; ++word) {
+    __bit_word found = *word ^ flip;
+    if (found != 0) {
+      return __bit_iterator(word, ::lem::__count_trailing_zeros64(found));
+    }
+  }
+  if (tail.offset_ != 0) {
+    __bit_word found = (*tail.word_ ^ flip) & ::lem::__bit_mask(0, tail.offset_);
+    if (found != 0) {
+      return __bit_iterator(tail.word_, ::lem::__count_trailing_zeros64(found));
+    }
+  }
+
+  return tail;
+}
+
+// overloads of the algorithms for bit iterators;
+template <typename T>
+inline void fill(__bit_iterator head, __bit_iterator tail, T const& value) {
+  ::lem::__bit_fill(head, tail, bool(value));
+}
+template <typename SizeType, typename T>
+inline __bit_iterator fill_n(__bit_iterator head, SizeType n, T const& value) {
+  if (n <= 0) {
+    return head;
+  }
+
+  ::lem::__bit_fill(head, head + n, bool(value));
+
+  return head + n;
+}
+template <typename T>
+inline ptrdiff_t count(__bit_iterator head, __bit_iterator tail, T const& value) {
+  ptrdiff_t set_num = ::lem::__bit_count(head, tail);
+  return (bool(value) ? set_num : (tail - head) - set_num);
+}
+template <typename T>
+inline __bit_iterator find(__bit_iterator head, __bit_iterator tail, T const& value) {
+  return ::lem::__bit_find(head, tail, bool(value));
+}
+/* end word-wide range operations */
+
+/* vector<bool> */
+template <typename AllocType, typename GrowthPolicy>
+class vector<bool, AllocType, GrowthPolicy> {
+ public:
+  // Member types;
+  // allocator traits;
+  using allocator_type    = AllocType;
+
+  // iterator traits;
+  using iterator          = __bit_iterator;
+  using reverse_iterator  = __bit_iterator;
+
+  // Data type;
+  using size_type         = size_t;
+  using value_type        = bool;
+  using diff_type         = ptrdiff_t;
+  using ref_type          = __bit_reference;
+  using word_type         = __bit_word;
+
+ protected:
+  // memory allocation;
+  using word_allocator    = ::lem::simple_alloc<word_type, allocator_type>;
+
+  // EM NOTE: as in vector, but the memory is counted in words;
+  //   | 1 1 0 ... 1 | 0 1 ... 0 | ... | 1 0 1 0 0 0 |   | ... |   |xxxxxx
+  //   ^                                       ^                   ^
+  //   |                                       |                   |
+  // mem_head_                             data_tail_           mem_tail_
+  word_type* mem_head_;
+  iterator data_tail_;
+  word_type* mem_tail_;
+
+  static size_type word_num(size_type n) {
+    return (n + __kWordBits - 1) / __kWordBits;
+  }
+  // the words are zeroed, see the EM NOTE on the bits beyond size();
+  static word_type* allocate_words(size_type n) {
+    word_type* words = word_allocator::allocate(n);
+    if (n != 0) {
+      ::std::memset(words, 0, n * sizeof(word_type));
+    }
+
+    return words;
+  }
+  // set empty storage for n bits;
+  void init_storage(size_type n) {
+    mem_head_ = allocate_words(word_num(n));
+    mem_tail_ = mem_head_ + word_num(n);
+    data_tail_ = begin() + n;
+
+    return;
+  }
+  // move the bits to the storage of word_capacity words;
+  void reallocate(size_type word_capacity) {
+    size_type n = size();
+    word_type* new_mem_head = allocate_words(word_capacity);
+    if (n != 0) {
+      ::std::memcpy(new_mem_head, mem_head_, word_num(n) * sizeof(word_type));
+    }
+    word_allocator::deallocate(mem_head_, mem_tail_ - mem_head_);
+
+    // update memory tags;
+    mem_head_ = new_mem_head;
+    mem_tail_ = new_mem_head + word_capacity;
+    data_tail_ = begin() + n;
+
+    return;
+  }
+  // words to reallocate for at least `required` bits, see vector::recommend();
+  size_type recommend_words(size_type required) const {
+    return word_allocator::good_size(GrowthPolicy::grow(mem_tail_ - mem_head_, word_num(required)));
+  }
+
+ public:
+  /* ctor */
+  // default ctor;
+  // ##usage: vector<bool> vct;
+  vector(void) : mem_head_(nullptr), data_tail_(), mem_tail_(nullptr) {}
+
+  // ctor;
+  // ##usage: vector<bool> vct({...});
+  vector(::std::initializer_list<bool> init_list) {
+    init_storage(init_list.size());
+    iterator cur = begin();
+    for (bool value : init_list) {
+      *cur++ = value;
+    }
+  }
+  explicit vector(size_type n, bool value = false) {
+    init_storage(n);
+    if (value) {
+      ::lem::__bit_fill(begin(), end(), true);
+    }
+  }
+
+  // copy ctor;
+  // ##usage: vector<bool> vct(SOME_VECTOR);
+  vector(vector const& other) {
+    init_storage(other.size());
+    if (!other.empty()) {
+      ::std::memcpy(mem_head_, other.mem_head_, word_num(other.size()) * sizeof(word_type));
+    }
+  }
+  // move ctor;
+  // ##usage: vector<bool> vct(std::move(SOME_VECTOR));
+  vector(vector&& other) noexcept
+      : mem_head_(other.mem_head_), data_tail_(other.data_tail_), mem_tail_(other.mem_tail_) {
+    other.mem_head_ = nullptr;
+    other.data_tail_ = iterator();
+    other.mem_tail_ = nullptr;
+  }
+
+  // assignment ctor;
+  // ##usage: vct = SOME_VECTOR;
+  vector& operator=(vector const& other) {
+    if (this == &other) {
+      return *this;
+    }
+
+    size_type other_words = word_num(other.size());
+    if (other.size() > capacity()) {
+      word_allocator::deallocate(mem_head_, mem_tail_ - mem_head_);
+      init_storage(0);
+      mem_head_ = allocate_words(other_words);
+      mem_tail_ = mem_head_ + other_words;
+    }
+    else if (word_num(size()) > other_words) {
+      // keep the bits beyond size() zero;
+      ::std::memset(mem_head_ + other_words, 0, (word_num(size()) - other_words) * sizeof(word_type));
+    }
+    if (other_words != 0) {
+      ::std::memcpy(mem_head_, other.mem_head_, other_words * sizeof(word_type));
+    }
+    data_tail_ = begin() + other.size();
+
+    return *this;
+  }
+  // move assignment;
+  // ##usage: vct = std::move(SOME_VECTOR);
+  vector& operator=(vector&& other) noexcept {
+    if (this != &other) {
+      vector cache(::std::move(other));
+      swap(cache);
+    }
+
+    return *this;
+  }
+  /* end ctor */
+
+  /* dtor */
+  ~vector(void) {
+    word_allocator::deallocate(mem_head_, mem_tail_ - mem_head_);
+  }
+  /* end dtor */
+
+  /* iterators */
+  iterator begin(void) const noexcept {
+    return iterator(mem_head_, 0);
+  }
+  iterator end(void) const noexcept {
+    return data_tail_;
+  }
+  /* end iterators */
+
+  /* accessors */
+  ref_type at(size_type ind) const {
+    if (ind >= size()) {
+      throw std::out_of_range("Invalid vector subscript. ");
+    }
+
+    return *(begin() + ind);
+  }
+  ref_type operator[](size_type ind) const noexcept {
+    return *(begin() + ind);
+  }
+  ref_type front(void) const noexcept {
+    return *(begin());
+  }
+  ref_type back(void) const noexcept {
+    return *(end() - 1);
+  }
+  /* end accessors */
+
+  /* capacity functions */
+  bool empty(void) const noexcept {
+    return begin() == end();
+  }
+  size_type size(void) const noexcept {
+    return (size_type)(end() - begin());
+  }
+  size_type capacity(void) const noexcept {
+    return (size_type)(mem_tail_ - mem_head_) * __kWordBits;
+  }
+  void reserve(size_type req) {
+    if (req <= capacity()) {
+      return;
+    }
+
+    reallocate(word_num(req));
+
+    return;
+  }
+  void shrink_to_fit(void) {
+    if (word_num(size()) == (size_type)(mem_tail_ - mem_head_)) {
+      return;
+    }
+
+    reallocate(word_num(size()));
+
+    return;
+  }
+  /* end capacity */
+
+  /* modifiers */
+  iterator insert(iterator pos_iter, bool value, size_type n = 1) {
+    if (n == 0) {
+      return pos_iter;
+    }
+
+    size_type offset = pos_iter - begin();
+    if (size() + n > capacity()) {
+      reallocate(recommend_words(size() + n));
+    }
+
+    // move [pos, end()) n bits backward;
+    iterator pos = begin() + offset;
+    iterator cur = end();
+    data_tail_ = cur + n;
+    for (iterator dest = data_tail_; cur != pos;) {
+      *--dest = bool(*--cur);
+    }
+    ::lem::__bit_fill(pos, pos + n, value);
+
+    return pos;
+  }
+  void push_back(bool value) {
+    if (data_tail_.word_ == mem_tail_) { // capacity full;
+      reallocate(recommend_words(size() + 1));
+    }
+
+    *data_tail_ = value;
+    ++data_tail_;
+
+    return;
+  }
+  void pop_back(void) {
+    if (empty()) {
+      throw lem::pop_empty_vector();
+    }
+
+    --data_tail_;
+    *data_tail_ = false;
+
+    return;
+  }
+  void resize(size_type n, bool value = false) {
+    if (n <= size()) {
+      ::lem::__bit_fill(begin() + n, end(), false);
+      data_tail_ = begin() + n;
+
+      return;
+    }
+
+    // Now n > size();
+    if (n > capacity()) {
+      reallocate(recommend_words(n));
+    }
+    iterator prev_data_tail = data_tail_;
+    data_tail_ = begin() + n;
+    if (value) {
+      ::lem::__bit_fill(prev_data_tail, data_tail_, true);
+    }
+
+    return;
+  }
+  // erase() returns the iterator following the last removed element;
+  iterator erase(iterator iter) {
+    if (iter == end()) {
+      return iter;
+    }
+
+    return erase(iter, iter + 1);
+  }
+  iterator erase(iterator head, iterator tail) {
+    iterator dest = head;
+    for (iterator cur = tail; cur != end(); ++cur, ++dest) {
+      *dest = bool(*cur);
+    }
+    ::lem::__bit_fill(dest, end(), false);
+    data_tail_ = dest;
+
+    return head;
+  }
+  void clear(void) {
+    erase(begin(), end());
+  }
+  void swap(vector& other) noexcept {
+    ::lem::swap(mem_head_, other.mem_head_);
+    ::lem::swap(data_tail_, other.data_tail_);
+    ::lem::swap(mem_tail_, other.mem_tail_);
+
+    return;
+  }
+  /* end modifiers */
+
+  /* word-wide operations */
+  // set every element to value;
+  void fill(bool value) {
+    ::lem::__bit_fill(begin(), end(), value);
+
+    return;
+  }
+  // flip every element;
+  void flip(void) {
+    for (word_type* word = mem_head_; word != mem_head_ + word_num(size()); ++word) {
+      *word = ~*word;
+    }
+    if (data_tail_.offset_ != 0) {
+      *data_tail_.word_ &= ::lem::__bit_mask(0, data_tail_.offset_);
+    }
+
+    return;
+  }
+  // number of true elements;
+  size_type count(void) const {
+    return (size_type)::lem::__bit_count(begin(), end());
+  }
+  // index of the first true element, or size() if there is none;
+  size_type find_first(void) const {
+    return (size_type)(::lem::__bit_find(begin(), end(), true) - begin());
+  }
+  // index of the first true element after ind, or size() if there is none;
+  // ##usage: for (size_t ind = vec.find_first(); ind != vec.size(); ind = vec.find_next(ind)) {...}
+  size_type find_next(size_type ind) const {
+    if (ind + 1 >= size()) {
+      return size();
+    }
+
+    return (size_type)(::lem::__bit_find(begin() + (ind + 1), end(), true) - begin());
+  }
+  /* end word-wide operations */
+};
+/* end vector<bool> */
+} /* end lem */
+
+#endif /* LEMSTL_LEM_BVECTOR_H_ */
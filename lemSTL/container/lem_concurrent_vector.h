@@ -0,0 +1,245 @@
+// Grow-only sequential containers for concurrent appending;
+#ifndef LEMSTL_LEM_CONCURRENT_VECTOR_H_
+#define LEMSTL_LEM_CONCURRENT_VECTOR_H_
+
+#include <atomic> // for std::atomic;
+#include <cstddef> // for size_t and std::ptrdiff_t;
+#include <new> // for placement new;
+
+#include "../lem_memory"
+#include "../lem_exception"
+#include "../lem_type_traits" // for __type_traits;
+#include "lem_stable_vector.h" // for chunk geometry;
+
+namespace lem {
+/* EM NOTE: concurrent_vector */
+// concurrent_vector only grows, and push_back() and grow_by() may be called
+// from many threads at once, together with reads by index.
+//
+// 1. An append claims its indices with a single fetch_add() on the size,
+//    so appending threads never wait for each other.
+// 2. The elements live in segments of the same geometry as the chunks of stable_vector,
+//    referred to by a fixed table in the object. Nothing is ever relocated,
+//    so a reader never sees an element move under it.
+// 3. The first thread to claim an index in a missing segment allocates it
+//    and installs it by compare_exchange. If another thread installed one first,
+//    the loser releases its own. Appends then take a bounded number of steps
+//    besides the allocation itself.
+// 4. Each element has a ready flag, set with release order once it is constructed.
+//    ready(ind) tells readers whether element ind can be read.
+//    size() counts the claimed indices, including the ones under construction.
+//
+// If the ctor of an element throws, its flag is never set, and the element
+// is skipped by readers and by the dtor.
+// clear() and the dtor must not run concurrently with anything.
+//
+// EM NOTE: the free-list allocator alloc is not thread-safe,
+// so the segments come from malloc_alloc by default.
+template <typename DataType, typename AllocType = ::lem::malloc_alloc, size_t FirstChunk = 16>
+class concurrent_vector {
+  static_assert(FirstChunk != 0 && (FirstChunk & (FirstChunk - 1)) == 0, "FirstChunk should be a power of 2. ");
+
+ public:
+  // Member types;
+  using allocator_type      = AllocType;
+
+  // Data type;
+  using size_type           = size_t;
+  using value_type          = DataType;
+  using diff_type           = ptrdiff_t;
+  using ptr_type            = DataType*;
+  using ref_type            = DataType&;
+
+ protected:
+  using flag_type           = ::std::atomic<unsigned char>;
+
+  // memory allocation;
+  // a segment is its elements followed by their ready flags;
+  using segment_allocator   = ::lem::simple_alloc<unsigned char, allocator_type>;
+
+  static constexpr size_type kLogFirst = ::lem::__static_log2(FirstChunk);
+  static constexpr size_type kMaxChunk = sizeof(size_type) * 8 - kLogFirst;
+
+  ::std::atomic<unsigned char*> segments_[kMaxChunk];
+  ::std::atomic<size_type> size_;
+
+ public:
+  /* ctor */
+  // default ctor;
+  // ##usage: concurrent_vector<...> vct;
+  concurrent_vector(void) : size_(0) {
+    for (size_type chunk = 0; chunk < kMaxChunk; ++chunk) {
+      segments_[chunk].store(nullptr, ::std::memory_order_relaxed);
+    }
+  }
+
+  // the elements may be read while they are copied, so there is no copy;
+  concurrent_vector(concurrent_vector const&) = delete;
+  concurrent_vector& operator=(concurrent_vector const&) = delete;
+  /* end ctor */
+
+  /* dtor */
+  ~concurrent_vector(void) {
+    clear();
+    for (size_type chunk = 0; chunk < kMaxChunk; ++chunk) {
+      unsigned char* segment = segments_[chunk].load(::std::memory_order_relaxed);
+      if (segment != nullptr) {
+        segment_allocator::deallocate(segment, segment_bytes(chunk));
+      }
+    }
+  }
+  /* end dtor */
+
+  /* accessors */
+  // element ind should be ready;
+  ref_type operator[](size_type ind) const noexcept {
+    return element_of(segment_of(ind), ::lem::__chunk_offset(ind, kLogFirst));
+  }
+  ref_type at(size_type ind) const {
+    if (!ready(ind)) {
+      throw std::out_of_range("Invalid vector subscript. ");
+    }
+
+    return operator[](ind);
+  }
+  // whether element ind has been constructed, and can be read;
+  bool ready(size_type ind) const noexcept {
+    if (ind >= size()) {
+      return false;
+    }
+
+    unsigned char* segment = segment_of(ind);
+    return segment != nullptr
+      && flag_of(segment, ::lem::__chunk_of(ind, kLogFirst), ::lem::__chunk_offset(ind, kLogFirst))
+        .load(::std::memory_order_acquire) != 0;
+  }
+  /* end accessors */
+
+  /* capacity functions */
+  bool empty(void) const noexcept {
+    return size() == 0;
+  }
+  // the number of claimed indices, some elements may still be under construction;
+  size_type size(void) const noexcept {
+    return size_.load(::std::memory_order_acquire);
+  }
+  // allocate the segments for indices [0, req) ahead, so that later appends do not allocate;
+  void reserve(size_type req) {
+    if (req == 0) {
+      return;
+    }
+
+    size_type last = ::lem::__chunk_of(req - 1, kLogFirst);
+    for (size_type chunk = 0; chunk <= last; ++chunk) {
+      install_segment(chunk);
+    }
+
+    return;
+  }
+  /* end capacity */
+
+  /* modifiers */
+  // returns the index of the new element;
+  // ##usage: size_t ind = vct.push_back(value);
+  size_type push_back(value_type const& value) {
+    size_type ind = size_.fetch_add(1, ::std::memory_order_acq_rel);
+    size_type chunk = ::lem::__chunk_of(ind, kLogFirst);
+    unsigned char* segment = install_segment(chunk);
+    size_type offset = ::lem::__chunk_offset(ind, kLogFirst);
+
+    ::lem::construct(&element_of(segment, offset), value);
+    flag_of(segment, chunk, offset).store(1, ::std::memory_order_release);
+
+    return ind;
+  }
+  // append n copies of value with one claim, and return the index of the first;
+  // ##usage: size_t head = vct.grow_by(64);
+  size_type grow_by(size_type n, value_type const& value = value_type()) {
+    size_type head = size_.fetch_add(n, ::std::memory_order_acq_rel);
+    if (n == 0) {
+      return head;
+    }
+
+    size_type last = ::lem::__chunk_of(head + n - 1, kLogFirst);
+    for (size_type chunk = ::lem::__chunk_of(head, kLogFirst); chunk <= last; ++chunk) {
+      install_segment(chunk);
+    }
+    for (size_type ind = head; ind != head + n; ++ind) {
+      size_type chunk = ::lem::__chunk_of(ind, kLogFirst);
+      unsigned char* segment = segments_[chunk].load(::std::memory_order_acquire);
+      size_type offset = ::lem::__chunk_offset(ind, kLogFirst);
+
+      ::lem::construct(&element_of(segment, offset), value);
+      flag_of(segment, chunk, offset).store(1, ::std::memory_order_release);
+    }
+
+    return head;
+  }
+  // destroy all the elements and keep the segments, NOT thread-safe;
+  void clear(void) {
+    size_type claimed = size_.load(::std::memory_order_relaxed);
+    for (size_type chunk = 0; chunk < kMaxChunk; ++chunk) {
+      size_type head = FirstChunk * ((size_type(1) << chunk) - 1);
+      if (head >= claimed) {
+        break;
+      }
+
+      unsigned char* segment = segments_[chunk].load(::std::memory_order_relaxed);
+      if (segment == nullptr) {
+        continue;
+      }
+      for (size_type offset = 0; offset < chunk_size(chunk) && head + offset < claimed; ++offset) {
+        flag_type& flag = flag_of(segment, chunk, offset);
+        if (flag.load(::std::memory_order_relaxed) != 0) {
+          ::lem::destroy(&element_of(segment, offset));
+          flag.store(0, ::std::memory_order_relaxed);
+        }
+      }
+    }
+    size_.store(0, ::std::memory_order_release);
+
+    return;
+  }
+  /* end modifiers */
+
+ protected:
+  static size_type chunk_size(size_type chunk) {
+    return FirstChunk << chunk;
+  }
+  static size_type segment_bytes(size_type chunk) {
+    return chunk_size(chunk) * sizeof(value_type) + chunk_size(chunk) * sizeof(flag_type);
+  }
+  static ref_type element_of(unsigned char* segment, size_type offset) {
+    return reinterpret_cast<ptr_type>(segment)[offset];
+  }
+  static flag_type& flag_of(unsigned char* segment, size_type chunk, size_type offset) {
+    return reinterpret_cast<flag_type*>(segment + chunk_size(chunk) * sizeof(value_type))[offset];
+  }
+  unsigned char* segment_of(size_type ind) const {
+    return segments_[::lem::__chunk_of(ind, kLogFirst)].load(::std::memory_order_acquire);
+  }
+
+  // return segment chunk, allocated by this thread or by another one;
+  unsigned char* install_segment(size_type chunk) {
+    unsigned char* segment = segments_[chunk].load(::std::memory_order_acquire);
+    if (segment != nullptr) {
+      return segment;
+    }
+
+    unsigned char* fresh = segment_allocator::allocate(segment_bytes(chunk));
+    for (size_type offset = 0; offset < chunk_size(chunk); ++offset) {
+      new (&flag_of(fresh, chunk, offset)) flag_type(0);
+    }
+    if (segments_[chunk].compare_exchange_strong(segment, fresh, ::std::memory_order_acq_rel, ::std::memory_order_acquire)) {
+      return fresh;
+    }
+
+    // another thread won, segment is its one;
+    segment_allocator::deallocate(fresh, segment_bytes(chunk));
+
+    return segment;
+  }
+};
+} /* end lem */
+
+#endif /* LEMSTL_LEM_CONCURRENT_VECTOR_H_ */
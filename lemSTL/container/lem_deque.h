@@ -11,6 +11,7 @@ using std::endl;
 
 #include <cstddef> // for std::ptrdiff_t;
 #include <initializer_list> // for std::initializer_list
+#include <utility> // for std::move();
 
 #include "../lem_memory"
 #include "../lem_iterator" // for distance();
@@ -182,12 +183,12 @@ struct __deque_iterator {
       // because different languages may use different rules for rounding.
       difference_type node_offset = offset > 0 ?\
         offset / difference_type(buffer_size()) :\
-        -((-offset) / difference_type(buffer_size()) + 1);
+        -((-offset - 1) / difference_type(buffer_size()) + 1);
 
       // move map_node_;
       set_node(map_node_ + node_offset);
       // move cur_;
-      cur_ = head_ + (-offset) % difference_type(buffer_size());
+      cur_ = head_ + (offset - node_offset * difference_type(buffer_size()));
     }
 
     return *this;
@@ -305,6 +306,45 @@ class deque {
 
     return;
   }
+  // free the buffers and the map, the elements should have been destroyed;
+  void destroy_deque_structure(void) {
+    if (map_ == nullptr) {
+      return;
+    }
+
+    for (map_pointer cur = head_.map_node_; cur <= tail_.map_node_; ++cur) {
+      data_allocator::deallocate(*cur, iterator::buffer_size());
+    }
+    map_allocator::deallocate(map_, map_size_);
+
+    return;
+  }
+
+  // copy [head, tail) to the uninitialized memory starting from head_;
+  // EM NOTE: the elements are copied run by run, each run being the longest range
+  // contiguous in both the source and the destination buffers,
+  // so that uninitialized_copy() copies trivial types by memmove.
+  void uninitialized_copy_by_buffer(iterator head, iterator tail) {
+    iterator dest = head_;
+    try {
+      while (head != tail) {
+        ptr_type run_tail = (head.map_node_ == tail.map_node_ ? tail.cur_ : head.tail_);
+        diff_type n = ::lem::min(run_tail - head.cur_, dest.tail_ - dest.cur_);
+
+        ::lem::uninitialized_copy(head.cur_, head.cur_ + n, dest.cur_);
+        head += n;
+        dest += n;
+      }
+    }
+    catch (::std::exception const& e) {
+      // commit or rollback semantics;
+      ::lem::destroy(head_, dest);
+      // throw out;
+      throw e;
+    }
+
+    return;
+  }
 
  public:
   /* ctor */
@@ -391,16 +431,78 @@ class deque {
   // ##usage: deque<...> dq = SOME_DEQUE;
   //  Here SOME_DEQUE will not be considered as ARGUMENT for copy ctor to construct a temp object,
   //  instead dq is directly constructed by copy ctor which is exactly like vct(SOME_DEQUE).
-  /* deque(deque<DataType, AllocType> const&) {} */ // deep copy for specific DataType;
+  deque(deque const& other) :
+    map_(nullptr),
+    map_size_(0),
+    head_(),
+    tail_()
+  {
+    if (other.empty()) {
+      return;
+    }
+
+    create_deque_structure(other.size());
+    try {
+      uninitialized_copy_by_buffer(other.head_, other.tail_);
+    }
+    catch (::std::exception const& e) {
+      // commit or rollback semantics;
+      destroy_deque_structure();
+      // throw out;
+      throw e;
+    }
+  }
+
+  // move ctor;
+  // The map and the buffers of other are taken over, and other is left empty;
+  // ##usage: deque<...> dq(std::move(SOME_DEQUE));
+  deque(deque&& other) noexcept :
+    map_(other.map_),
+    map_size_(other.map_size_),
+    head_(other.head_),
+    tail_(other.tail_)
+  {
+    other.map_ = nullptr;
+    other.map_size_ = 0;
+    other.head_ = iterator();
+    other.tail_ = iterator();
+  }
 
   // assignment ctor;
   // deep copy for specific DataType;
   // Notice that assignment ctor is used to change data of initialized objects.
   // ##usage: dq = SOME_DEQUE;
-  /* deque<DataType, AllocType> operator=(deque<DataType, AllocType>) {} */
+  deque& operator=(deque const& other) {
+    if (this != &other) {
+      deque cache(other);
+      swap(cache);
+    }
+
+    return *this;
+  }
+  // move assignment;
+  // ##usage: dq = std::move(SOME_DEQUE);
+  deque& operator=(deque&& other) noexcept {
+    if (this != &other) {
+      deque cache(::std::move(other));
+      swap(cache);
+    }
+
+    return *this;
+  }
 
   /* end ctor */
 
+  /* dtor */
+  ~deque(void) {
+    #ifdef LEM_DEBUG
+      cout << "\tLEM_DEBUG: Call ~deque(). " << endl;
+    #endif
+    ::lem::destroy(head_, tail_);
+    destroy_deque_structure();
+  }
+  /* end dtor */
+
   /* iterators */
   iterator begin(void) const noexcept {
     return head_;
@@ -437,8 +539,25 @@ class deque {
     return tail_ - head_;
   }
   /* end capacity functions */
+
+  /* modifiers */
+  // exchange the maps of two deques, O(1);
+  void swap(deque& other) noexcept {
+    ::lem::swap(map_, other.map_);
+    ::lem::swap(map_size_, other.map_size_);
+    ::lem::swap(head_, other.head_);
+    ::lem::swap(tail_, other.tail_);
+
+    return;
+  }
+  /* end modifiers */
 };
 
+template <typename DataType, typename AllocType, size_t BufSiz>
+inline void swap(deque<DataType, AllocType, BufSiz>& a, deque<DataType, AllocType, BufSiz>& b) noexcept {
+  a.swap(b);
+}
+
 /* deque __type_traits */
 template <typename DataType, typename AllocType>
 struct __type_traits<deque<DataType, AllocType>> {
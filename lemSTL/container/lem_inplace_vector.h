@@ -0,0 +1,484 @@
+// Sequential containers with fixed capacity;
+#ifndef LEMSTL_LEM_INPLACE_VECTOR_H_
+#define LEMSTL_LEM_INPLACE_VECTOR_H_
+
+#include <cstddef> // for std::ptrdiff_t;
+#include <initializer_list> // for std::initializer_list
+#include <new> // for placement new;
+#include <utility> // for std::move();
+
+#include "../lem_memory"
+#include "../lem_iterator"
+#include "../lem_exception"
+#include "../lem_type_traits" // for __type_traits;
+
+/* NOTICE ON try-catch BLOCKS FOR CONTAINERS */
+// See lem_vector.h. The same commit or rollback pattern is used here.
+
+namespace lem {
+/* EM NOTE: inplace_vector */
+// inplace_vector keeps at most N elements in a buffer inside the object,
+// and never allocates: exceeding N throws vector_overflow,
+// or fails softly with try_push_back().
+// Unlike small_vector, only the size is stored, so the object
+// is the buffer and one word, and every operation is deterministic.
+//
+// Copying, moving and swapping are O(size()), as the elements live in the object:
+// a move moves the elements one by one instead of stealing a buffer.
+template <typename DataType, size_t N>
+class inplace_vector {
+ public:
+  // Member types;
+  // iterator traits;
+  using iterator          = DataType*;
+  using reverse_iterator  = DataType*;
+
+  // Data type;
+  using size_type         = size_t;
+  using value_type        = DataType;
+  using diff_type         = ptrdiff_t;
+  using ptr_type          = DataType*;
+  using ref_type          = DataType&;
+
+ protected:
+  alignas(DataType) unsigned char storage_[(N == 0 ? 1 : N) * sizeof(DataType)];
+  size_type size_;
+
+  iterator mem_head(void) const noexcept {
+    return reinterpret_cast<iterator>(const_cast<unsigned char*>(storage_));
+  }
+  // throw if n more elements do not fit;
+  void check_room(size_type n) const {
+    if (n > N - size_) {
+      throw ::lem::vector_overflow();
+    }
+
+    return;
+  }
+  // move the elements of other, which is left empty;
+  // *this should be empty;
+  void take_over(inplace_vector& other) {
+    iterator cur = mem_head();
+    try {
+      for (iterator mov = other.begin(); mov != other.end(); ++mov, ++cur) {
+        ::new (static_cast<void*>(cur)) value_type(::std::move(*mov));
+      }
+    }
+    catch (::std::exception const& e) {
+      // commit or rollback semantics;
+      ::lem::destroy(mem_head(), cur);
+      // throw out;
+      throw e;
+    }
+    size_ = other.size();
+    other.clear();
+
+    return;
+  }
+
+ public:
+  /* ctor */
+  // default ctor;
+  // ##usage: inplace_vector<..., 16> vct;
+  inplace_vector(void) : size_(0) {}
+
+  // ctor;
+  // ##usage: inplace_vector<..., 16> vct({...});
+  inplace_vector(::std::initializer_list<DataType> init_list) : size_(0) {
+    check_room(init_list.size());
+    try {
+      ::lem::uninitialized_copy(init_list.begin(), init_list.end(), mem_head());
+    }
+    catch (::std::exception const& e) {
+      // commit or rollback semantics;
+      ::lem::destroy(mem_head(), mem_head() + init_list.size());
+      // throw out;
+      throw e;
+    }
+
+    size_ = init_list.size();
+  }
+  explicit inplace_vector(size_type n, value_type const& value = value_type()) : size_(0) {
+    check_room(n);
+    try {
+      ::lem::uninitialized_fill_n(mem_head(), n, value);
+    }
+    catch (::std::exception const& e) {
+      // commit or rollback semantics;
+      ::lem::destroy(mem_head(), mem_head() + n);
+      // throw out;
+      throw e;
+    }
+
+    size_ = n;
+  }
+
+  // copy ctor;
+  // ##usage: inplace_vector<..., 16> vct(SOME_INPLACE_VECTOR);
+  inplace_vector(inplace_vector const& other) : size_(0) {
+    try {
+      ::lem::uninitialized_copy(other.begin(), other.end(), mem_head());
+    }
+    catch (::std::exception const& e) {
+      // commit or rollback semantics;
+      ::lem::destroy(mem_head(), mem_head() + other.size());
+      // throw out;
+      throw e;
+    }
+
+    size_ = other.size();
+  }
+
+  // move ctor, O(size());
+  // ##usage: inplace_vector<..., 16> vct(std::move(SOME_INPLACE_VECTOR));
+  inplace_vector(inplace_vector&& other) : size_(0) {
+    take_over(other);
+  }
+
+  // assignment ctor;
+  // ##usage: vct = SOME_INPLACE_VECTOR;
+  inplace_vector& operator=(inplace_vector const& other) {
+    if (this != &other) {
+      assign(other.begin(), other.end());
+    }
+
+    return *this;
+  }
+  // move assignment, O(size() + other.size());
+  // ##usage: vct = std::move(SOME_INPLACE_VECTOR);
+  inplace_vector& operator=(inplace_vector&& other) {
+    if (this != &other) {
+      clear();
+      take_over(other);
+    }
+
+    return *this;
+  }
+  /* end ctor */
+
+  /* dtor */
+  ~inplace_vector(void) {
+    ::lem::destroy(begin(), end());
+  }
+  /* end dtor */
+
+  /* iterators */
+  iterator begin(void) const noexcept {
+    return mem_head();
+  }
+  iterator end(void) const noexcept {
+    return mem_head() + size_;
+  }
+  /* end iterators */
+
+  /* accessors */
+  ref_type at(size_type ind) const {
+    if (ind >= size()) {
+      throw std::out_of_range("Invalid vector subscript. ");
+    }
+
+    return *(begin() + ind);
+  }
+  ref_type operator[](size_type ind) const noexcept {
+    return *(begin() + ind);
+  }
+  ref_type front(void) const noexcept {
+    return *(begin());
+  }
+  ref_type back(void) const noexcept {
+    return *(end() - 1);
+  }
+  /* end accessors */
+
+  /* capacity functions */
+  bool empty(void) const noexcept {
+    return size_ == 0;
+  }
+  size_type size(void) const noexcept {
+    return size_;
+  }
+  static constexpr size_type capacity(void) noexcept {
+    return N;
+  }
+  static constexpr size_type max_size(void) noexcept {
+    return N;
+  }
+  // nothing to reserve, but asking for more than N is an error;
+  void reserve(size_type req) const {
+    if (req > N) {
+      throw ::lem::vector_overflow();
+    }
+
+    return;
+  }
+  void shrink_to_fit(void) const noexcept {}
+  /* end capacity */
+
+  /* modifiers */
+  iterator insert(iterator pos_iter, value_type const& value, size_type n = 1) {
+    if (n == 0) {
+      return pos_iter;
+    }
+    check_room(n);
+
+    size_type num_after_pos = end() - pos_iter;
+    iterator prev_data_tail = end();
+    if (num_after_pos >= n) {
+      // deal with data in uninitialized memory;
+      ::lem::uninitialized_copy(prev_data_tail - n, prev_data_tail, prev_data_tail);
+      size_ += n;
+      // move the rest part of existed data;
+      ::lem::copy_backward(pos_iter, prev_data_tail - n, prev_data_tail);
+      // fill new data;
+      ::lem::fill_n(pos_iter, n, value);
+    }
+    else {
+      // deal with data in uninitialized memory;
+      ::lem::uninitialized_fill_n(prev_data_tail, n - num_after_pos, value);
+      size_ += n - num_after_pos;
+      // move existed data;
+      ::lem::uninitialized_copy(pos_iter, prev_data_tail, end());
+      size_ += num_after_pos;
+      // fill the rest part of new data;
+      ::lem::fill_n(pos_iter, num_after_pos, value);
+    }
+
+    return pos_iter;
+  }
+  // insert [head, tail) before pos_iter, see vector::insert();
+  template <typename InputIterator, typename = ::lem::__enable_if_iterator<InputIterator>>
+  iterator insert(iterator pos_iter, InputIterator head, InputIterator tail) {
+    return insert_range(pos_iter, head, tail, ::lem::get_iterator_category(head));
+  }
+  template <typename InputIterator, typename = ::lem::__enable_if_iterator<InputIterator>>
+  void append(InputIterator head, InputIterator tail) {
+    insert_range(end(), head, tail, ::lem::get_iterator_category(head));
+
+    return;
+  }
+  template <typename InputIterator, typename = ::lem::__enable_if_iterator<InputIterator>>
+  void assign(InputIterator head, InputIterator tail) {
+    iterator cur = begin();
+    for (; head != tail && cur != end(); ++head, ++cur) {
+      *cur = *head;
+    }
+    erase(cur, end());
+    append(head, tail);
+
+    return;
+  }
+
+  void push_back(const value_type& value) {
+    check_room(1);
+    ::lem::construct(end(), value);
+    ++size_;
+
+    return;
+  }
+  // push_back() without throwing vector_overflow,
+  // return the new element, or nullptr if the vector is full;
+  // ##usage: if (vct.try_push_back(value) == nullptr) {...}
+  ptr_type try_push_back(const value_type& value) {
+    if (size_ == N) {
+      return nullptr;
+    }
+
+    ::lem::construct(end(), value);
+    ++size_;
+
+    return end() - 1;
+  }
+  void pop_back(void) {
+    if (empty()) {
+      throw lem::pop_empty_vector();
+    }
+
+    --size_;
+    ::lem::destroy(end());
+
+    return;
+  }
+  void resize(size_type n, value_type const& value = value_type()) {
+    if (n <= size()) {
+      ::lem::destroy(begin() + n, end());
+      size_ = n;
+
+      return;
+    }
+
+    // Now n > size();
+    check_room(n - size());
+    try {
+      ::lem::uninitialized_fill_n(end(), n - size(), value);
+    }
+    catch (::std::exception const& e) {
+      // commit or rollback semantics;
+      ::lem::destroy(end(), begin() + n);
+      // throw out;
+      throw e;
+    }
+
+    size_ = n;
+
+    return;
+  }
+  // see vector::resize_default_init();
+  void resize_default_init(size_type n) {
+    if (n <= size()) {
+      resize(n);
+
+      return;
+    }
+
+    check_room(n - size());
+    using triv_ctor = typename __type_traits<value_type>::has_trivial_default_ctor;
+    default_init_tail(n - size(), triv_ctor());
+
+    return;
+  }
+  void resize_for_overwrite(size_type n) {
+    resize_default_init(n);
+
+    return;
+  }
+  // see vector::reserve_and_append();
+  template <typename Writer>
+  size_type reserve_and_append(size_type n, Writer writer) {
+    check_room(n);
+
+    size_type written = (size_type)writer(end(), n);
+    if (written > n) {
+      throw lem::vector_overflow("The writer reports more elements than the room it was given. ");
+    }
+    size_ += written;
+
+    return written;
+  }
+  // erase() returns the iterator following the last removed element;
+  iterator erase(iterator iter) {
+    if (iter == end()) {
+      return iter;
+    }
+
+    return erase(iter, iter + 1);
+  }
+  iterator erase(iterator head, iterator tail) {
+    iterator new_data_tail = ::lem::copy(tail, end(), head);
+    ::lem::destroy(new_data_tail, end());
+    size_ = new_data_tail - begin();
+
+    return head;
+  }
+  template <typename UnaryPredicate>
+  size_type erase_if(UnaryPredicate pred) {
+    iterator new_data_tail = ::lem::remove_if(begin(), end(), pred);
+    size_type count = end() - new_data_tail;
+    erase(new_data_tail, end());
+
+    return count;
+  }
+  void clear(void) {
+    erase(begin(), end());
+  }
+  // exchange the elements, O(max(size(), other.size()));
+  void swap(inplace_vector& other) {
+    inplace_vector* shorter = (size() < other.size() ? this : &other);
+    inplace_vector* longer = (shorter == this ? &other : this);
+    size_type common = shorter->size();
+
+    ::lem::swap_ranges(shorter->begin(), shorter->end(), longer->begin());
+    shorter->append(longer->begin() + common, longer->end());
+    longer->erase(longer->begin() + common, longer->end());
+
+    return;
+  }
+  /* end modifiers */
+
+ protected:
+  template <typename InputIterator>
+  iterator insert_range(iterator pos_iter, InputIterator head, InputIterator tail, ::lem::input_iterator_tag) {
+    size_type offset = pos_iter - begin();
+    for (iterator cur = pos_iter; head != tail; ++head) {
+      cur = insert(cur, *head) + 1;
+    }
+
+    return begin() + offset;
+  }
+  template <typename ForwardIterator>
+  iterator insert_range(iterator pos_iter, ForwardIterator head, ForwardIterator tail, ::lem::forward_iterator_tag) {
+    size_type n = (size_type)::lem::distance(head, tail);
+    if (n == 0) {
+      return pos_iter;
+    }
+    check_room(n);
+
+    size_type num_after_pos = end() - pos_iter;
+    iterator prev_data_tail = end();
+    if (num_after_pos > n) {
+      // deal with data in uninitialized memory;
+      ::lem::uninitialized_copy(prev_data_tail - n, prev_data_tail, prev_data_tail);
+      size_ += n;
+      // move the rest part of existed data;
+      ::lem::copy_backward(pos_iter, prev_data_tail - n, prev_data_tail);
+      // copy new data;
+      ::lem::copy(head, tail, pos_iter);
+    }
+    else {
+      ForwardIterator mid = head;
+      ::lem::advance(mid, num_after_pos);
+      // deal with data in uninitialized memory;
+      ::lem::uninitialized_copy(mid, tail, prev_data_tail);
+      size_ += n - num_after_pos;
+      // move existed data;
+      ::lem::uninitialized_copy(pos_iter, prev_data_tail, end());
+      size_ += num_after_pos;
+      // copy the rest part of new data;
+      ::lem::copy(head, mid, pos_iter);
+    }
+
+    return pos_iter;
+  }
+
+  void default_init_tail(size_type n, ::lem::__true_tag) {
+    size_ += n;
+
+    return;
+  }
+  void default_init_tail(size_type n, ::lem::__false_tag) {
+    iterator cur = end();
+    try {
+      for (; n != 0; --n, ++cur) {
+        ::lem::default_construct(cur);
+      }
+    }
+    catch (::std::exception const& e) {
+      // commit or rollback semantics;
+      ::lem::destroy(end(), cur);
+      // throw out;
+      throw e;
+    }
+
+    size_ = cur - begin();
+
+    return;
+  }
+};
+
+template <typename DataType, size_t N>
+inline void swap(inplace_vector<DataType, N>& a, inplace_vector<DataType, N>& b) {
+  a.swap(b);
+}
+
+/* inplace_vector __type_traits */
+template <typename DataType, size_t N>
+struct __type_traits<inplace_vector<DataType, N>> {
+  using has_trivial_default_ctor = ::lem::__false_tag;
+  using has_trivial_copy_ctor = ::lem::__false_tag;
+  using has_trivial_assignment_oprtr = ::lem::__false_tag;
+  using has_trivial_dtor = ::lem::__false_tag;
+  using is_POD_type = ::lem::__false_tag;
+};
+/* end __type_traits */
+} /* end lem */
+
+#endif /* LEMSTL_LEM_INPLACE_VECTOR_H_ */
@@ -17,6 +17,7 @@
 #include "../lem_iterator" // for distance();
 #include "../lem_exception"
 #include "../lem_type_traits" // for __type_traits;
+#include "../algorithm/lem_prefetch.h" // for __list_prefetch_walk();
 
 /* NOTICE ON try-catch BLOCKS FOR CONTAINERS */
 // EM NOTE: be caution to the logic of try-catch blocks:
@@ -45,11 +46,16 @@
 // to let the user know this construction failure. 
 
 namespace lem {
+// EM NOTE: the links and the data of a node are split,
+// so that the header of a list can be a data-less __list_node_base
+// embedded in the list object.
+struct __list_node_base {
+  __list_node_base* pred_ = nullptr;
+  __list_node_base* next_ = nullptr;
+};
 template <typename DataType>
-struct __list_node {
+struct __list_node : __list_node_base {
   DataType data_;
-  __list_node<DataType>* pred_ = nullptr;
-  __list_node<DataType>* next_ = nullptr;
 };
 
 template <typename DataType, typename PointerType, typename ReferenceType>
@@ -63,19 +69,21 @@ struct __list_iterator {
   using self                  = __list_iterator<DataType, PointerType, ReferenceType>;
   using iterator              = __list_iterator<DataType, DataType*, DataType&>;
   using node_pointer          = __list_node<DataType>*;
+  using link_pointer          = __list_node_base*;
 
   // data;
-  node_pointer node_;
+  link_pointer node_;
 
   // ctor;
   __list_iterator(void) : node_(nullptr) {}
-  explicit __list_iterator(node_pointer node) : node_(node) {}
+  explicit __list_iterator(link_pointer node) : node_(node) {}
   
-  __list_iterator(iterator const& iter) : node_(iter.node_) {
-    #if defined LEM_DEBUG && 0
-      cout << "Call list iterator copy ctor. " << endl;
-    #endif
-  }
+  __list_iterator(self const&) = default;
+  // iterator to const_iterator;
+  template <typename Iter, typename = typename ::std::enable_if<::std::is_same<Iter, iterator>::value && !::std::is_same<Iter, self>::value>::type>
+  __list_iterator(Iter const& iter) : node_(iter.node_) {}
+
+  self& operator=(self const&) = default;
 
   // equality;
   bool operator==(self const& iter) const {
@@ -87,7 +95,7 @@ struct __list_iterator {
 
   // dereference;
   reference_type operator*(void) const {
-    return node_->data_;
+    return static_cast<node_pointer>(node_)->data_;
   }
 
   // member access;
@@ -144,6 +152,7 @@ class list {
   using ref_type            = DataType&;
   using node_type           = ::lem::__list_node<value_type>;
   using node_pointer        = ::lem::__list_node<value_type>*;
+  using link_pointer        = ::lem::__list_node_base*;
 
  protected:
   using list_node_allocator = ::lem::simple_alloc<node_type, allocator_type>;
@@ -159,33 +168,53 @@ class list {
   //     ^             ^
   //     |             |
   //    end()       begin()
-  node_pointer head_; // pointer to empty header node;
+  //
+  // The header holds no data and lives in the list object,
+  // so empty lists never allocate, e.g. the 65 lists of sort().
+  // Its neighbours point back to it, so swap() has to relink them.
+  __list_node_base head_; // empty header node;
+  size_type size_; // number of elements, kept by every modifier so that size() is O(1);
+
+  link_pointer header(void) const noexcept {
+    return const_cast<link_pointer>(&head_);
+  }
+  // point the header to itself, i.e. make the list empty;
+  void reset_header(void) noexcept {
+    head_.next_ = header();
+    head_.pred_ = header();
+  }
+  // point the neighbours of a moved header back to it;
+  void relink_header(void) noexcept {
+    if (size_ == 0) {
+      reset_header();
+    }
+    else {
+      head_.next_->pred_ = header();
+      head_.pred_->next_ = header();
+    }
+  }
 
  public:
   /* ctor */
   // default ctor;
   // ##usage: list<...> lst;
-  list(void) {
+  list(void) : size_(0) {
     #ifdef LEM_DEBUG
       cout << "Call list default ctor. " << endl;
     #endif
 
-    head_ = list_node_allocator::allocate();
-    head_->next_ = head_;
-    head_->pred_ = head_;
+    reset_header();
   }
 
   // ctor;
   // ##usage: list<...> lst({...});
-  list(::std::initializer_list<value_type> init_list) {
+  list(::std::initializer_list<value_type> init_list) : size_(0) {
     #ifdef LEM_DEBUG
       cout << "Call list init-list ctor. " << endl;
     #endif
 
     // set header node;
-    head_ = list_node_allocator::allocate();
-    head_->next_ = head_;
-    head_->pred_ = head_;
+    reset_header();
 
     try {
       // build data;
@@ -206,25 +235,27 @@ class list {
         ::lem::construct(&(newNode->data_), *iter);
 
         // link to list;
-        newNode->next_ = head_;
-        newNode->pred_ = head_->pred_;
-        head_->pred_->next_ = newNode;
-        head_->pred_ = newNode;
+        newNode->next_ = header();
+        newNode->pred_ = head_.pred_;
+        head_.pred_->next_ = newNode;
+        head_.pred_ = newNode;
+        ++size_;
       }
     }
     catch (::std::exception const& e) {
       // commit or rollback semantics;
       // destroy data;
-      ::lem::destroy(iterator(head_->next_), iterator(head_));
-      for (; head_->pred_ != head_;) {
-        node_pointer cur = head_->pred_;
+      ::lem::destroy(begin(), end());
+      for (; head_.pred_ != header();) {
+        node_pointer cur = static_cast<node_pointer>(head_.pred_);
 
-        cur->pred_->next_ = head_;
-        head_->pred_ = cur->pred_;
+        cur->pred_->next_ = header();
+        head_.pred_ = cur->pred_;
 
         // deallocate memory;
         list_node_allocator::deallocate(cur);
       }
+      size_ = 0;
       // throw out;
       throw e;
     }
@@ -240,13 +271,59 @@ class list {
   // ##usage: list<...> lst = SOME_LIST;
   //  Here SOME_LIST will not be considered as ARGUMENT for copy ctor to construct a temp object,
   //  instead lst is directly constructed by copy ctor which is exactly like vct(SOME_LIST).
-  /* list(list<DataType, AllocType> const&) {} */ // deep copy for specific DataType;
+  // EM NOTE: the object is complete once the delegated default ctor returns,
+  // so the dtor frees the copied nodes if a copy throws.
+  list(list const& other) : list() {
+    for (iterator iter = other.begin(); iter != other.end(); ++iter) {
+      push_back(*iter);
+    }
+  }
+
+  // move ctor;
+  // Nothing is allocated, the nodes of other are taken over by swap();
+  // ##usage: list<...> lst(std::move(SOME_LIST));
+  list(list&& other) : list() {
+    swap(other);
+  }
 
   // assignment ctor;
   // deep copy for specific DataType;
   // Notice that assignment ctor is used to change data of initialized objects.
+  // The existed nodes are reused, so only the extra elements cost an allocation;
   // ##usage: lst = SOME_LIST;
-  /* list<DataType, AllocType> operator=(list<DataType, AllocType>) {} */
+  list& operator=(list const& other) {
+    if (this == &other) {
+      return *this;
+    }
+
+    iterator iter = begin();
+    iterator jter = other.begin();
+    for (; iter != end() && jter != other.end(); ++iter, ++jter) {
+      *iter = *jter;
+    }
+    if (jter == other.end()) {
+      while (iter != end()) {
+        iter = erase(iter);
+      }
+    }
+    else {
+      for (; jter != other.end(); ++jter) {
+        push_back(*jter);
+      }
+    }
+
+    return *this;
+  }
+  // move assignment;
+  // ##usage: lst = std::move(SOME_LIST);
+  list& operator=(list&& other) noexcept {
+    if (this != &other) {
+      clear();
+      swap(other);
+    }
+
+    return *this;
+  }
 
   /* end ctor */
 
@@ -257,29 +334,26 @@ class list {
     #endif
 
     // destroy data;
-    ::lem::destroy(iterator(head_->next_), iterator(head_));
+    ::lem::destroy(begin(), end());
     // free memory;
-    while (head_->pred_ != head_) {
-      node_pointer cur = head_->pred_;
+    while (head_.pred_ != header()) {
+      node_pointer cur = static_cast<node_pointer>(head_.pred_);
 
-      cur->pred_->next_ = head_;
-      head_->pred_ = cur->pred_;
+      cur->pred_->next_ = header();
+      head_.pred_ = cur->pred_;
 
       // deallocate memory;
       list_node_allocator::deallocate(cur);
     }
-
-    // deallocate header;
-    list_node_allocator::deallocate(head_);
   }
   /* end dtor */
 
   /* iterators */
   iterator begin(void) const noexcept {
-    return iterator(head_->next_);
+    return iterator(head_.next_);
   }
   iterator end(void) const noexcept {
-    return iterator(head_);
+    return iterator(header());
   }
   /* edn iterators */
 
@@ -297,7 +371,7 @@ class list {
     return (begin() == end());
   }
   size_type size(void) const noexcept {
-    return ::lem::distance(begin(), end());
+    return size_;
   }
   /* end capacity */
 
@@ -312,6 +386,7 @@ class list {
     newNode->next_ = iter.node_;
     iter.node_->pred_->next_ = newNode;
     iter.node_->pred_ = newNode;
+    ++size_;
 
     return iterator(newNode); // build iterator via __list_node;
   }
@@ -333,16 +408,18 @@ class list {
     }
 
     // pop iter;
-    node_pointer pred = iter.node_->pred_;
-    node_pointer next = iter.node_->next_;
+    link_pointer pred = iter.node_->pred_;
+    link_pointer next = iter.node_->next_;
 
     pred->next_ = next; 
     next->pred_ = pred;
 
     // destroy iter;
-    ::lem::destroy(&(iter.node_->data_));
+    node_pointer node = static_cast<node_pointer>(iter.node_);
+    ::lem::destroy(&(node->data_));
     // free memory;
-    list_node_allocator::deallocate(iter.node_);
+    list_node_allocator::deallocate(node);
+    --size_;
 
     return iterator(next);
   }
@@ -372,21 +449,39 @@ class list {
 
     return count;
   }
+  template <typename UnaryPredicate>
+  size_type remove_if(UnaryPredicate pred) {
+    size_type count = 0;
+    iterator iter = begin();
+
+    while (iter != end()) {
+      if (pred(*iter)) {
+        iter = erase(iter);
+        ++count;
+      }
+      else {
+        ++iter;
+      }
+    }
+
+    return count;
+  }
 
   void clear(void) {
     // destroy data;
     ::lem::destroy(begin(), end());
 
     // free memory;
-    while (head_->pred_ != head_) {
-      node_pointer cur = head_->pred_;
+    while (head_.pred_ != header()) {
+      node_pointer cur = static_cast<node_pointer>(head_.pred_);
 
-      cur->pred_->next_ = head_;
-      head_->pred_ = cur->pred_;
+      cur->pred_->next_ = header();
+      head_.pred_ = cur->pred_;
 
       // deallocate memory;
       list_node_allocator::deallocate(cur);
     }
+    size_ = 0;
 
     return;
   }
@@ -413,6 +508,30 @@ class list {
 
     return count;
   }
+  // pred(a, b) tells whether b is a duplicate of the kept element a;
+  template <typename BinaryPredicate>
+  size_type unique(BinaryPredicate pred) {
+    if (empty()) {
+      return 0;
+    }
+
+    size_type count = 0;
+    iterator curFirst = begin();
+    iterator mov = ++begin();
+
+    while (mov != end()) {
+      if (pred(*curFirst, *mov)) {
+        mov = erase(mov);
+        ++count;
+      }
+      else {
+        curFirst = mov;
+        ++mov;
+      }
+    }
+
+    return count;
+  }
 
  protected:
   // transfer [head, tail) to the front of iter.
@@ -454,7 +573,7 @@ class list {
     //                             |          head                                              |    tail
     //                             --------------------------------------------------------------
     
-    node_pointer cache = iter.node_->pred_;
+    link_pointer cache = iter.node_->pred_;
     //                  cache                 iter
     //                    |                    |
     //                    v                    v
@@ -508,6 +627,8 @@ class list {
     }
 
     transfer(iter, lst.begin(), lst.end());
+    size_ += lst.size_;
+    lst.size_ = 0;
 
     return;
   }
@@ -544,6 +665,8 @@ class list {
     }
 
     transfer(iter, head, tail);
+    ++size_;
+    --lst.size_;
 
     return;
   }
@@ -552,7 +675,7 @@ class list {
       if (this == &lst) {
         iterator mov = head;
         while (mov != tail) {
-          if (mov == lst.head_) {
+          if (mov == lst.end()) {
             throw ::lem::mov_header();
           }
           if (mov == iter) {
@@ -566,7 +689,29 @@ class list {
       return;
     }
 
+    // EM NOTE: the nodes have to be counted when they come from another list,
+    // pass the count to the overload below to keep splicing O(1).
+    size_type count = (this == &lst) ? 0 : size_type(::lem::distance(head, tail));
     transfer(iter, head, tail);
+    size_ += count;
+    lst.size_ -= count;
+
+    return;
+  }
+  // count should be distance(head, tail);
+  // lst should be another list: the range cannot be checked against iter in O(1),
+  // so splicing inside one list goes through the overload above;
+  void splice(iterator const iter, list<DataType, AllocType>& lst, iterator const head, iterator const tail, size_type count) {
+    if (this == &lst) {
+      throw ::lem::self_splice("Counted self-splicing. ");
+    }
+    if (head == tail) {
+      return;
+    }
+
+    transfer(iter, head, tail);
+    size_ += count;
+    lst.size_ -= count;
 
     return;
   }
@@ -597,12 +742,15 @@ class list {
     if (jter != jterEnd) {
       transfer(iter, jter, jterEnd);
     }
+    // all the nodes of other are taken;
+    size_ += other.size_;
+    other.size_ = 0;
 
     return;
   }
 
   void reverse(void) {
-    if (head_->next_ == head_ || head_->next_->next_ == head_) { // .size() == 0 or 1;
+    if (size_ <= 1) {
       return;
     }
 
@@ -617,10 +765,12 @@ class list {
     return;
   }
 
-  void swap(list<DataType, AllocType>& other) {
-    iterator sep = begin();
-    splice(begin(), other);
-    other.splice(other.begin(), *this, sep, end());
+  // exchange the links of the header nodes, O(1);
+  void swap(list<DataType, AllocType>& other) noexcept {
+    ::lem::swap(head_, other.head_);
+    ::lem::swap(size_, other.size_);
+    relink_header();
+    other.relink_header();
 
     return;
   }
@@ -630,7 +780,7 @@ class list {
   // This algorithm is given by Hou Jie in 'The Annotated STL Source'.
   // See https://blog.csdn.net/Ryansior/article/details/126848942 for details.
   void sort(void) {
-    if (head_->next_ == head_ || head_->next_->next_ == head_) { // .size() == 0 or 1;
+    if (size_ <= 1) {
       return;
     }
 
@@ -670,8 +820,29 @@ class list {
     return;
   }
   /* end sort */
+
+  /* traversal */
+  // Call f on each element, prefetching the node `distance` hops ahead.
+  // Larger distances hide more latency when f is cheap, see lem_prefetch.h;
+  // ##usage: lst.for_each_prefetch([&sum](int x) { sum += x; });
+  template <typename UnaryFunction>
+  UnaryFunction for_each_prefetch(UnaryFunction f, size_type distance = __kListPrefetchDistance) const {
+    auto visit = [&f](ref_type data) {
+      f(data);
+      return false;
+    };
+    ::lem::__list_prefetch_walk(begin(), end(), visit, distance);
+
+    return f;
+  }
+  /* end traversal */
 };
 
+template <typename DataType, typename AllocType>
+inline void swap(list<DataType, AllocType>& a, list<DataType, AllocType>& b) noexcept {
+  a.swap(b);
+}
+
 /* list __type_traits */
 template <typename DataType, typename AllocType>
 struct __type_traits<list<DataType, AllocType>> {
@@ -0,0 +1,87 @@
+// Container adaptors;
+#ifndef LEMSTL_LEM_QUEUE_H_
+#define LEMSTL_LEM_QUEUE_H_
+
+#include <cstddef> // for size_t;
+#include <initializer_list> // for std::initializer_list
+
+#include "../lem_vector" // for default underlying container;
+#include "../lem_algorithm" // for heap algorithms;
+#include "../lem_functional" // for less;
+
+namespace lem {
+// See declarations at https://en.cppreference.com/w/cpp/container/priority_queue;
+// EM NOTE: Arity is the arity of the underlying heap.
+// A 4-ary heap does fewer levels of sift per push() and pop(),
+// which pays off when elements are pushed and popped millions of times.
+// ##usage: priority_queue<int> pq; // binary max-heap;
+// ##usage: priority_queue<int, vector<int>, greater<int>, 4> pq; // 4-ary min-heap;
+template <typename DataType,
+          typename Sequence = ::lem::vector<DataType>,
+          typename Compare = ::lem::less<DataType>,
+          size_t Arity = 2
+          >
+class priority_queue {
+  static_assert(Arity >= 2, "Heap arity should be at least 2. ");
+
+ public:
+  using container_type    = Sequence;
+  using value_compare     = Compare;
+
+  using size_type         = typename Sequence::size_type;
+  using value_type        = typename Sequence::value_type;
+
+ protected:
+  Sequence seq_; // underlying container, kept as a heap;
+  Compare comp_;
+
+ public:
+  /* ctor */
+  // default ctor;
+  // ##usage: priority_queue<...> pq;
+  priority_queue(void) : seq_(), comp_() {}
+  explicit priority_queue(Compare const& comp) : seq_(), comp_(comp) {}
+
+  // ctor;
+  // ##usage: priority_queue<...> pq({...});
+  priority_queue(::std::initializer_list<value_type> init_list, Compare const& comp = Compare()) :
+    seq_(init_list),
+    comp_(comp)
+  {
+    ::lem::make_heap<Arity>(seq_.begin(), seq_.end(), comp_);
+  }
+  /* end ctor */
+
+  /* accessors */
+  value_type const& top(void) const noexcept {
+    return seq_.front();
+  }
+  /* end accessors */
+
+  /* capacity */
+  bool empty(void) const noexcept {
+    return seq_.empty();
+  }
+  size_type size(void) const noexcept {
+    return seq_.size();
+  }
+  /* end capacity */
+
+  /* modifiers */
+  void push(value_type const& value) {
+    seq_.push_back(value);
+    ::lem::push_heap<Arity>(seq_.begin(), seq_.end(), comp_);
+
+    return;
+  }
+  void pop(void) {
+    ::lem::pop_heap<Arity>(seq_.begin(), seq_.end(), comp_);
+    seq_.pop_back(); // throws if the queue is empty;
+
+    return;
+  }
+  /* end modifiers */
+};
+} /* end lem */
+
+#endif /* LEMSTL_LEM_QUEUE_H_ */
@@ -0,0 +1,549 @@
+// Sequential containers with inline storage;
+#ifndef LEMSTL_LEM_SMALL_VECTOR_H_
+#define LEMSTL_LEM_SMALL_VECTOR_H_
+
+#ifdef LEM_DEBUG
+  #include <iostream> // for cout, endl;
+  #include <cstdlib> // for exit();
+
+  using std::cout;
+  using std::endl;
+#endif
+
+#include <cstddef> // for std::ptrdiff_t;
+#include <initializer_list> // for std::initializer_list
+#include <new> // for placement new;
+#include <utility> // for std::move();
+
+#include "../lem_memory"
+#include "../lem_iterator"
+#include "../lem_exception"
+#include "../lem_type_traits" // for __type_traits;
+#include "lem_vector.h" // for growth policies;
+
+/* NOTICE ON try-catch BLOCKS FOR CONTAINERS */
+// See lem_vector.h. The same commit or rollback pattern is used here.
+
+namespace lem {
+/* EM NOTE: small_vector */
+// small_vector keeps up to N elements in a buffer inside the object,
+// and moves to the allocator only when it grows beyond N.
+// Small vectors then cost no allocation at all, and their elements
+// share the cache lines of the object itself.
+//
+// The layout is the one of vector, so every algorithm on pointers works the same;
+// mem_head_ simply points to the inline buffer as long as the elements fit:
+//
+//                         inline_
+//                <----------------------->
+//   | mem_head_ | data_tail_ | mem_tail_ | 1 | 2 | ... | n |   | ... |   |
+//        |           |           |        ^                 ^           ^
+//        |           |           |        |                 |           |
+//        +-----------+-----------+------->+                 |           |
+//                    +----------------------------------->  +           |
+//                                +--------------------------------->    +
+//
+// Iterators are invalidated by moving between the inline buffer and the heap,
+// as by any reallocation of vector. The inline buffer is never given back
+// to the allocator. Moving a small_vector takes over its heap block,
+// but moves the elements one by one out of an inline buffer, and so does swap().
+template <typename DataType, size_t N, typename AllocType = alloc, typename GrowthPolicy = growth_factor_2>
+class small_vector {
+  static_assert(N > 0, "small_vector needs an inline capacity, use vector instead. ");
+
+ public:
+  // Member types;
+  // allocator traits;
+  using allocator_type    = AllocType;
+
+  // iterator traits;
+  using iterator          = DataType*;
+  using reverse_iterator  = DataType*;
+
+  // Data type;
+  using size_type         = size_t;
+  using value_type        = DataType;
+  using diff_type         = ptrdiff_t;
+  using ptr_type          = DataType*;
+  using ref_type          = DataType&;
+
+ protected:
+  // memory allocation;
+  using data_allocator    = ::lem::simple_alloc<value_type, allocator_type>;
+
+  iterator mem_head_;
+  iterator data_tail_;
+  iterator mem_tail_;
+  alignas(DataType) unsigned char inline_[N * sizeof(DataType)];
+
+  iterator inline_head(void) const noexcept {
+    return reinterpret_cast<iterator>(const_cast<unsigned char*>(inline_));
+  }
+
+  // set empty storage for n elements, inline if they fit;
+  void init_storage(size_type n) {
+    mem_head_ = (n <= N ? inline_head() : data_allocator::allocate(n));
+    data_tail_ = mem_head_;
+    mem_tail_ = mem_head_ + (n <= N ? N : n);
+
+    return;
+  }
+  // deallocate the storage if it is on the heap;
+  void free_storage(void) {
+    if (!is_inline()) {
+      data_allocator::deallocate(mem_head_, mem_tail_ - mem_head_);
+    }
+
+    return;
+  }
+  // take the elements of other, which is left empty and inline;
+  // *this should have empty inline storage;
+  void take_over(small_vector& other) {
+    if (!other.is_inline()) {
+      mem_head_ = other.mem_head_;
+      data_tail_ = other.data_tail_;
+      mem_tail_ = other.mem_tail_;
+      other.init_storage(0);
+
+      return;
+    }
+
+    iterator cur = mem_head_;
+    try {
+      for (iterator mov = other.begin(); mov != other.end(); ++mov, ++cur) {
+        ::new (static_cast<void*>(cur)) value_type(::std::move(*mov));
+      }
+    }
+    catch (::std::exception const& e) {
+      // commit or rollback semantics;
+      ::lem::destroy(mem_head_, cur);
+      // throw out;
+      throw e;
+    }
+    data_tail_ = cur;
+    other.clear();
+
+    return;
+  }
+
+ public:
+  /* ctor */
+  // default ctor;
+  // ##usage: small_vector<..., 8> vct;
+  small_vector(void) {
+    init_storage(0);
+  }
+
+  // ctor;
+  // ##usage: small_vector<..., 8> vct({...});
+  small_vector(::std::initializer_list<DataType> init_list) {
+    init_storage(init_list.size());
+    try {
+      ::lem::uninitialized_copy(init_list.begin(), init_list.end(), mem_head_);
+    }
+    catch (::std::exception const& e) {
+      // commit or rollback semantics;
+      ::lem::destroy(mem_head_, mem_head_ + init_list.size());
+      free_storage();
+      // throw out;
+      throw e;
+    }
+
+    // set memory tags;
+    data_tail_ = mem_head_ + init_list.size();
+  }
+  explicit small_vector(size_type n, value_type const& value = value_type()) {
+    init_storage(n);
+    try {
+      ::lem::uninitialized_fill_n(mem_head_, n, value);
+    }
+    catch (::std::exception const& e) {
+      // commit or rollback semantics;
+      ::lem::destroy(mem_head_, mem_head_ + n);
+      free_storage();
+      // throw out;
+      throw e;
+    }
+
+    // set memory tags;
+    data_tail_ = mem_head_ + n;
+  }
+
+  // copy ctor;
+  // EM NOTE: the implicit one would copy the pointers into the inline buffer of other;
+  // ##usage: small_vector<..., 8> vct(SOME_SMALL_VECTOR);
+  small_vector(small_vector const& other) {
+    init_storage(other.size());
+    try {
+      ::lem::uninitialized_copy(other.begin(), other.end(), mem_head_);
+    }
+    catch (::std::exception const& e) {
+      // commit or rollback semantics;
+      ::lem::destroy(mem_head_, mem_head_ + other.size());
+      free_storage();
+      // throw out;
+      throw e;
+    }
+
+    // set memory tags;
+    data_tail_ = mem_head_ + other.size();
+  }
+
+  // move ctor;
+  // ##usage: small_vector<..., 8> vct(std::move(SOME_SMALL_VECTOR));
+  small_vector(small_vector&& other) {
+    init_storage(0);
+    take_over(other);
+  }
+
+  // assignment ctor;
+  // ##usage: vct = SOME_SMALL_VECTOR;
+  small_vector& operator=(small_vector const& other) {
+    if (this == &other) {
+      return *this;
+    }
+
+    clear();
+    reserve(other.size());
+    try {
+      data_tail_ = ::lem::uninitialized_copy(other.begin(), other.end(), mem_head_);
+    }
+    catch (::std::exception const& e) {
+      // commit or rollback semantics;
+      ::lem::destroy(mem_head_, mem_head_ + other.size());
+      // throw out;
+      throw e;
+    }
+
+    return *this;
+  }
+  // move assignment;
+  // ##usage: vct = std::move(SOME_SMALL_VECTOR);
+  small_vector& operator=(small_vector&& other) {
+    if (this == &other) {
+      return *this;
+    }
+
+    ::lem::destroy(begin(), end());
+    free_storage();
+    init_storage(0);
+    take_over(other);
+
+    return *this;
+  }
+  /* end ctor */
+
+  /* dtor */
+  ~small_vector(void) {
+    #ifdef LEM_DEBUG
+      cout << "\tLEM_DEBUG: Call ~small_vector(). " << endl;
+    #endif
+    ::lem::destroy(mem_head_, data_tail_);
+    free_storage();
+  }
+  /* end dtor */
+
+  /* iterators */
+  iterator begin(void) const noexcept {
+    return mem_head_;
+  }
+  iterator end(void) const noexcept {
+    return data_tail_;
+  }
+  /* end iterators */
+
+  /* accessors */
+  ref_type at(size_type ind) const {
+    if (ind >= size()) {
+      throw std::out_of_range("Invalid vector subscript. ");
+    }
+
+    return *(begin() + ind);
+  }
+  ref_type operator[](size_type ind) const noexcept {
+    return *(begin() + ind);
+  }
+  ref_type front(void) const noexcept {
+    return *(begin());
+  }
+  ref_type back(void) const noexcept {
+    return *(end() - 1);
+  }
+  /* end accessors */
+
+  /* capacity functions */
+  bool empty(void) const noexcept {
+    return begin() == end();
+  }
+  size_type size(void) const noexcept {
+    return (size_type)(end() - begin());
+  }
+  size_type capacity(void) const noexcept {
+    return (size_type)(mem_tail_ - begin());
+  }
+  // the elements are in the inline buffer;
+  bool is_inline(void) const noexcept {
+    return mem_head_ == inline_head();
+  }
+  void reserve(size_type req) {
+    if (req <= capacity()) {
+      return;
+    }
+
+    reallocate(req);
+
+    return;
+  }
+  // Move the elements back to the inline buffer if they fit,
+  // or to a heap block of the exact size otherwise;
+  void shrink_to_fit(void) {
+    if (is_inline() || size() == capacity()) {
+      return;
+    }
+
+    reallocate(size());
+
+    return;
+  }
+  /* end capacity */
+
+ protected:
+  // capacity to reallocate for at least `required` elements, see vector::recommend();
+  size_type recommend(size_type required) const {
+    return data_allocator::good_size(GrowthPolicy::grow(capacity(), required));
+  }
+
+  // move the elements to storage for new_capacity >= size() elements;
+  void reallocate(size_type new_capacity) {
+    bool to_inline = (new_capacity <= N);
+    iterator new_mem_head = (to_inline ? inline_head() : data_allocator::allocate(new_capacity));
+    iterator new_data_tail = new_mem_head;
+    try {
+      new_data_tail = ::lem::uninitialized_copy(mem_head_, data_tail_, new_mem_head);
+    }
+    catch (::std::exception const& e) {
+      // commit or rollback semantics;
+      ::lem::destroy(new_mem_head, new_mem_head + size());
+      if (!to_inline) {
+        data_allocator::deallocate(new_mem_head, new_capacity);
+      }
+      // throw out;
+      throw e;
+    }
+
+    // delete prev storage;
+    ::lem::destroy(begin(), end());
+    free_storage();
+
+    // update memory tags;
+    mem_head_ = new_mem_head;
+    data_tail_ = new_data_tail;
+    mem_tail_ = new_mem_head + (to_inline ? N : new_capacity);
+
+    return;
+  }
+
+ public:
+  /* modifiers */
+  iterator insert(iterator pos_iter, value_type const& value, size_type n = 1) {
+    if (n == 0) {
+      return pos_iter;
+    }
+
+    // if capacity is large enough;
+    if (n <= (size_type)(mem_tail_ - data_tail_)) {
+      size_type num_after_pos = data_tail_ - pos_iter;
+      iterator prev_data_tail = data_tail_;
+      if (num_after_pos >= n) {
+        // deal with data in uninitialized memory;
+        ::lem::uninitialized_copy(data_tail_ - n, data_tail_, data_tail_);
+        data_tail_ += n;
+        // move the rest part of existed data;
+        ::lem::copy_backward(pos_iter, prev_data_tail - n, prev_data_tail);
+        // fill new data;
+        ::lem::fill_n(pos_iter, n, value);
+      }
+      else {
+        // deal with data in uninitialized memory;
+        ::lem::uninitialized_fill_n(data_tail_, n - num_after_pos, value);
+        data_tail_ += n - num_after_pos;
+        // move existed data;
+        ::lem::uninitialized_copy(pos_iter, prev_data_tail, data_tail_);
+        data_tail_ += num_after_pos;
+        // fill the rest part of new data;
+        ::lem::fill_n(pos_iter, num_after_pos, value);
+      }
+
+      return pos_iter;
+    }
+
+    // Now capacity not enough, the elements leave the inline buffer;
+    size_type new_capacity = recommend(size() + n);
+    iterator new_mem_head = data_allocator::allocate(new_capacity);
+    iterator new_pos = new_mem_head + (pos_iter - mem_head_);
+    iterator new_data_tail = new_mem_head;
+
+    try {
+      new_data_tail = ::lem::uninitialized_copy(mem_head_, pos_iter, new_mem_head);
+      new_data_tail = ::lem::uninitialized_fill_n(new_data_tail, n, value);
+      new_data_tail = ::lem::uninitialized_copy(pos_iter, data_tail_, new_data_tail);
+    }
+    catch (::std::exception const& e) {
+      // commit or rollback semantics;
+      ::lem::destroy(new_mem_head, new_mem_head + new_capacity);
+      data_allocator::deallocate(new_mem_head, new_capacity);
+      // throw out;
+      throw e;
+    }
+
+    // delete prev storage;
+    ::lem::destroy(mem_head_, data_tail_);
+    free_storage();
+
+    // update memory tags;
+    mem_head_ = new_mem_head;
+    data_tail_ = new_data_tail;
+    mem_tail_ = mem_head_ + new_capacity;
+
+    return new_pos;
+  }
+  void push_back(const value_type& value) {
+    if (data_tail_ != mem_tail_) { // memory available;
+      ::lem::construct(end(), value);
+      ++data_tail_;
+
+      return;
+    }
+
+    // Now capacity full;
+    // EM NOTE: value is constructed before the old storage is released,
+    // so it may refer to an element of this small_vector.
+    size_type new_size = recommend(capacity() + 1);
+    iterator new_mem_head = data_allocator::allocate(new_size);
+    iterator new_data_tail = new_mem_head;
+    try {
+      // copy data;
+      new_data_tail = ::lem::uninitialized_copy(mem_head_, data_tail_, new_mem_head);
+      // insert new data;
+      ::lem::construct(new_data_tail, value);
+      ++new_data_tail;
+    }
+    catch (::std::exception const& e) {
+      // commit or rollback semantics;
+      ::lem::destroy(new_mem_head, new_data_tail);
+      data_allocator::deallocate(new_mem_head, new_size);
+      // throw out;
+      throw e;
+    }
+
+    // delete prev storage;
+    ::lem::destroy(begin(), end());
+    free_storage();
+
+    // update memory tags;
+    mem_head_ = new_mem_head;
+    mem_tail_ = new_mem_head + new_size;
+    data_tail_ = new_data_tail;
+
+    return;
+  }
+  void pop_back(void) {
+    if (empty()) {
+      throw lem::pop_empty_vector();
+    }
+
+    // Now non-empty vector;
+    --data_tail_;
+    ::lem::destroy(data_tail_);
+
+    return;
+  }
+  void resize(size_type n, value_type const& value = value_type()) {
+    if (n <= size()) {
+      ::lem::destroy(mem_head_ + n, data_tail_);
+      data_tail_ = mem_head_ + n;
+
+      return;
+    }
+
+    // Now n > size();
+    if (n > capacity()) {
+      reallocate(recommend(n));
+    }
+    try {
+      ::lem::uninitialized_fill_n(data_tail_, n - size(), value);
+    }
+    catch (::std::exception const& e) {
+      // commit or rollback semantics;
+      ::lem::destroy(data_tail_, mem_head_ + n);
+      // throw out;
+      throw e;
+    }
+
+    // update memory tags;
+    data_tail_ = mem_head_ + n;
+
+    return;
+  }
+  // erase() returns the iterator following the last removed element;
+  iterator erase(iterator iter) {
+    if (iter == end()) {
+      return iter;
+    }
+
+    ::lem::copy(iter + 1, end(), iter);
+    --data_tail_;
+    ::lem::destroy(data_tail_);
+
+    return iter;
+  }
+  iterator erase(iterator head, iterator tail) {
+    iterator new_data_tail = ::lem::copy(tail, end(), head);
+    ::lem::destroy(new_data_tail, end());
+    data_tail_ = new_data_tail;
+
+    return head;
+  }
+  void clear(void) {
+    erase(begin(), end());
+  }
+  // exchange the heap blocks, O(1), or move the elements if either one is inline;
+  void swap(small_vector& other) {
+    if (this == &other) {
+      return;
+    }
+    if (!is_inline() && !other.is_inline()) {
+      ::lem::swap(mem_head_, other.mem_head_);
+      ::lem::swap(data_tail_, other.data_tail_);
+      ::lem::swap(mem_tail_, other.mem_tail_);
+
+      return;
+    }
+
+    small_vector cache(::std::move(other));
+    other = ::std::move(*this);
+    *this = ::std::move(cache);
+
+    return;
+  }
+  /* end modifiers */
+};
+
+template <typename DataType, size_t N, typename AllocType, typename GrowthPolicy>
+inline void swap(small_vector<DataType, N, AllocType, GrowthPolicy>& a, small_vector<DataType, N, AllocType, GrowthPolicy>& b) {
+  a.swap(b);
+}
+
+/* small_vector __type_traits */
+template <typename DataType, size_t N, typename AllocType, typename GrowthPolicy>
+struct __type_traits<small_vector<DataType, N, AllocType, GrowthPolicy>> {
+  using has_trivial_default_ctor = ::lem::__false_tag;
+  using has_trivial_copy_ctor = ::lem::__false_tag;
+  using has_trivial_assignment_oprtr = ::lem::__false_tag;
+  using has_trivial_dtor = ::lem::__false_tag;
+  using is_POD_type = ::lem::__false_tag;
+};
+/* end __type_traits */
+} /* end lem */
+
+#endif /* LEMSTL_LEM_SMALL_VECTOR_H_ */
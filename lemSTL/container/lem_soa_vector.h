@@ -0,0 +1,427 @@
+// Structure-of-arrays sequential containers;
+#ifndef LEMSTL_LEM_SOA_VECTOR_H_
+#define LEMSTL_LEM_SOA_VECTOR_H_
+
+#include <cstddef> // for size_t and std::ptrdiff_t;
+#include <tuple> // for std::tuple;
+#include <utility> // for std::index_sequence;
+
+#include "../lem_memory"
+#include "../lem_exception"
+#include "../lem_type_traits" // for __type_traits;
+#include "lem_vector.h" // for growth_factor_2;
+
+/* NOTICE ON try-catch BLOCKS FOR CONTAINERS */
+// See lem_vector.h. The same commit or rollback pattern is used here.
+
+namespace lem {
+/* EM NOTE: soa_vector */
+// vector<Record> stores whole records one after another (array of structures),
+// so a loop reading 2 fields of a 12-field record drags all 12 through the cache.
+// soa_vector<Fields...> stores each field in its own array (structure of arrays):
+//
+//   column<0>()  | f0 f0 f0 ... f0 |   ...   |
+//   column<1>()  | f1 f1 f1 ... f1 |   ...   |
+//   ...
+//   <------- size() ------->
+//   <------------ capacity() ------------>
+//
+// A scan of one field then reads nothing else, and column<I>() is a native pointer,
+// so the algorithms take their native pointer (and SIMD) paths on it.
+// All the columns share one allocation and one growth path, and each column
+// starts at a multiple of __kColumnAlign bytes.
+constexpr size_t __kColumnAlign = 64; // cache line;
+
+template <typename... Fields>
+class soa_vector {
+  static_assert(sizeof...(Fields) > 0, "soa_vector needs at least one field. ");
+
+ public:
+  // Member types;
+  using allocator_type    = ::lem::alloc;
+
+  // Data type;
+  using size_type         = size_t;
+  using value_type        = ::std::tuple<Fields...>;
+  using diff_type         = ptrdiff_t;
+
+  template <size_t I>
+  using field_type        = typename ::std::tuple_element<I, value_type>::type;
+
+  static constexpr size_t kFieldNum = sizeof...(Fields);
+
+ protected:
+  // memory allocation;
+  using byte_allocator    = ::lem::simple_alloc<unsigned char, allocator_type>;
+  using column_index      = ::std::index_sequence_for<Fields...>;
+
+  unsigned char* mem_; // the single block of all the columns;
+  size_type mem_size_;
+  ::std::tuple<Fields*...> columns_;
+  size_type size_;
+  size_type capacity_;
+
+ public:
+  /* row_reference */
+  // Proxy of the row ind, i.e. the ind-th element of every column;
+  // ##usage: soa[ind].get<1>() = value;
+  class row_reference {
+   protected:
+    soa_vector* owner_;
+    size_type ind_;
+
+   public:
+    row_reference(soa_vector* owner, size_type ind) : owner_(owner), ind_(ind) {}
+
+    template <size_t I>
+    field_type<I>& get(void) const {
+      return owner_->template column<I>()[ind_];
+    }
+    operator value_type(void) const {
+      return owner_->row_value(ind_, column_index());
+    }
+    row_reference& operator=(value_type const& values) {
+      owner_->assign_row(ind_, values, column_index());
+      return *this;
+    }
+  };
+  /* end row_reference */
+
+  /* ctor */
+  // default ctor;
+  // ##usage: soa_vector<...> soa;
+  soa_vector(void) : mem_(nullptr), mem_size_(0), columns_(), size_(0), capacity_(0) {}
+
+  // copy ctor;
+  // ##usage: soa_vector<...> soa(SOME_SOA_VECTOR);
+  soa_vector(soa_vector const& other) : soa_vector() {
+    allocate_columns(other.size());
+    try {
+      copy_columns<0>(other.columns_, other.size());
+    }
+    catch (::std::exception const& e) {
+      // commit or rollback semantics;
+      // the delegated ctor has finished, so the dtor will run and should find no block;
+      byte_allocator::deallocate(mem_, mem_size_);
+      allocate_columns(0);
+      // throw out;
+      throw e;
+    }
+    size_ = other.size();
+  }
+  // move ctor;
+  // ##usage: soa_vector<...> soa(std::move(SOME_SOA_VECTOR));
+  soa_vector(soa_vector&& other) noexcept : soa_vector() {
+    swap(other);
+  }
+
+  // assignment ctor;
+  // ##usage: soa = SOME_SOA_VECTOR;
+  soa_vector& operator=(soa_vector const& other) {
+    if (this != &other) {
+      soa_vector cache(other);
+      swap(cache);
+    }
+
+    return *this;
+  }
+  // move assignment;
+  // ##usage: soa = std::move(SOME_SOA_VECTOR);
+  soa_vector& operator=(soa_vector&& other) noexcept {
+    if (this != &other) {
+      soa_vector cache(::std::move(other));
+      swap(cache);
+    }
+
+    return *this;
+  }
+  /* end ctor */
+
+  /* dtor */
+  ~soa_vector(void) {
+    destroy_rows(0, size_, column_index());
+    byte_allocator::deallocate(mem_, mem_size_);
+  }
+  /* end dtor */
+
+  /* accessors */
+  // the array of field I, contiguous and aligned to __kColumnAlign;
+  // ##usage: double* prices = soa.column<2>();
+  template <size_t I>
+  field_type<I>* column(void) const noexcept {
+    return ::std::get<I>(columns_);
+  }
+  row_reference operator[](size_type ind) noexcept {
+    return row_reference(this, ind);
+  }
+  row_reference at(size_type ind) {
+    if (ind >= size()) {
+      throw std::out_of_range("Invalid vector subscript. ");
+    }
+
+    return row_reference(this, ind);
+  }
+  row_reference front(void) noexcept {
+    return row_reference(this, 0);
+  }
+  row_reference back(void) noexcept {
+    return row_reference(this, size_ - 1);
+  }
+  /* end accessors */
+
+  /* capacity functions */
+  bool empty(void) const noexcept {
+    return size_ == 0;
+  }
+  size_type size(void) const noexcept {
+    return size_;
+  }
+  size_type capacity(void) const noexcept {
+    return capacity_;
+  }
+  void reserve(size_type req) {
+    if (req <= capacity()) {
+      return;
+    }
+
+    reallocate(req);
+
+    return;
+  }
+  void shrink_to_fit(void) {
+    if (size() == capacity()) {
+      return;
+    }
+
+    reallocate(size());
+
+    return;
+  }
+  /* end capacity */
+
+  /* modifiers */
+  // ##usage: soa.push_back(id, price, volume);
+  void push_back(Fields const&... values) {
+    if (size_ != capacity_) {
+      construct_row<0>(size_, ::std::tuple<Fields const&...>(values...));
+      ++size_;
+
+      return;
+    }
+
+    // Now capacity full;
+    // EM NOTE: values are copied out before reallocation,
+    // since they may refer to the elements of this soa_vector.
+    value_type cache(values...);
+    reallocate(GrowthPolicy::grow(capacity_, size_ + 1));
+    construct_row<0>(size_, cache);
+    ++size_;
+
+    return;
+  }
+  void push_back(value_type const& values) {
+    push_back_tuple(values, column_index());
+
+    return;
+  }
+  void pop_back(void) {
+    if (empty()) {
+      throw lem::pop_empty_vector();
+    }
+
+    --size_;
+    destroy_rows(size_, size_ + 1, column_index());
+
+    return;
+  }
+  // new rows are value-initialized;
+  void resize(size_type n) {
+    if (n <= size_) {
+      destroy_rows(n, size_, column_index());
+      size_ = n;
+
+      return;
+    }
+
+    reserve(n > capacity_ ? GrowthPolicy::grow(capacity_, n) : n);
+    while (size_ < n) {
+      construct_row<0>(size_, value_type());
+      ++size_;
+    }
+
+    return;
+  }
+  void clear(void) {
+    destroy_rows(0, size_, column_index());
+    size_ = 0;
+
+    return;
+  }
+  void swap(soa_vector& other) noexcept {
+    ::lem::swap(mem_, other.mem_);
+    ::lem::swap(mem_size_, other.mem_size_);
+    ::lem::swap(columns_, other.columns_);
+    ::lem::swap(size_, other.size_);
+    ::lem::swap(capacity_, other.capacity_);
+
+    return;
+  }
+  /* end modifiers */
+
+ protected:
+  using GrowthPolicy = ::lem::growth_factor_2;
+
+  static size_type align_up(size_type bytes) {
+    return (bytes + __kColumnAlign - 1) / __kColumnAlign * __kColumnAlign;
+  }
+
+  // Set mem_ and columns_ to a new block for capacity rows;
+  // the previous block is NOT released, and no element is constructed.
+  void allocate_columns(size_type capacity) {
+    if (capacity == 0) {
+      mem_ = nullptr;
+      mem_size_ = 0;
+      columns_ = ::std::tuple<Fields*...>();
+      capacity_ = 0;
+
+      return;
+    }
+
+    size_type const field_sizes[] = { sizeof(Fields)... };
+    size_type offsets[kFieldNum];
+    size_type bytes = 0;
+    for (size_type ind = 0; ind < kFieldNum; ++ind) {
+      offsets[ind] = bytes;
+      bytes = align_up(bytes + capacity * field_sizes[ind]);
+    }
+
+    // the block from the allocator is only aligned to the word,
+    // the extra bytes align the first column;
+    mem_size_ = bytes + __kColumnAlign;
+    mem_ = byte_allocator::allocate(mem_size_);
+    unsigned char* head = mem_ + (__kColumnAlign - size_type(mem_) % __kColumnAlign) % __kColumnAlign;
+    set_columns(head, offsets, column_index());
+    capacity_ = capacity;
+
+    return;
+  }
+  template <size_t... I>
+  void set_columns(unsigned char* head, size_type const* offsets, ::std::index_sequence<I...>) {
+    columns_ = ::std::tuple<Fields*...>(reinterpret_cast<Fields*>(head + offsets[I])...);
+
+    return;
+  }
+
+  // move all the rows to a new block for capacity rows;
+  void reallocate(size_type capacity) {
+    unsigned char* prev_mem = mem_;
+    size_type prev_mem_size = mem_size_;
+    ::std::tuple<Fields*...> prev_columns = columns_;
+    size_type prev_capacity = capacity_;
+
+    allocate_columns(capacity);
+    try {
+      copy_columns<0>(prev_columns, size_);
+    }
+    catch (::std::exception const& e) {
+      // commit or rollback semantics;
+      byte_allocator::deallocate(mem_, mem_size_);
+      mem_ = prev_mem;
+      mem_size_ = prev_mem_size;
+      columns_ = prev_columns;
+      capacity_ = prev_capacity;
+      // throw out;
+      throw e;
+    }
+
+    // delete prev columns;
+    destroy_columns(prev_columns, 0, size_, column_index());
+    byte_allocator::deallocate(prev_mem, prev_mem_size);
+
+    return;
+  }
+
+  // copy n rows of source into the uninitialized columns_, column by column;
+  // EM NOTE: each column is a single uninitialized_copy(), i.e. a single memmove
+  // for trivial fields. If a copy throws, the columns done are destroyed.
+  template <size_t I>
+  typename ::std::enable_if<(I < kFieldNum)>::type
+  copy_columns(::std::tuple<Fields*...> const& source, size_type n) {
+    field_type<I>* head = ::std::get<I>(source);
+    ::lem::uninitialized_copy(head, head + n, ::std::get<I>(columns_));
+    try {
+      copy_columns<I + 1>(source, n);
+    }
+    catch (::std::exception const& e) {
+      // commit or rollback semantics;
+      ::lem::destroy(::std::get<I>(columns_), ::std::get<I>(columns_) + n);
+      // throw out;
+      throw e;
+    }
+  }
+  template <size_t I>
+  typename ::std::enable_if<(I == kFieldNum)>::type
+  copy_columns(::std::tuple<Fields*...> const&, size_type) {}
+
+  // construct the fields of row ind from values;
+  template <size_t I, typename Tuple>
+  typename ::std::enable_if<(I < kFieldNum)>::type
+  construct_row(size_type ind, Tuple const& values) {
+    ::lem::construct(::std::get<I>(columns_) + ind, ::std::get<I>(values));
+    try {
+      construct_row<I + 1>(ind, values);
+    }
+    catch (::std::exception const& e) {
+      // commit or rollback semantics;
+      ::lem::destroy(::std::get<I>(columns_) + ind);
+      // throw out;
+      throw e;
+    }
+  }
+  template <size_t I, typename Tuple>
+  typename ::std::enable_if<(I == kFieldNum)>::type
+  construct_row(size_type, Tuple const&) {}
+
+  template <size_t... I>
+  void destroy_columns(::std::tuple<Fields*...> const& columns, size_type head, size_type tail, ::std::index_sequence<I...>) {
+    int expand[] = { 0, (::lem::destroy(::std::get<I>(columns) + head, ::std::get<I>(columns) + tail), 0)... };
+    (void)expand;
+  }
+  template <size_t... I>
+  void destroy_rows(size_type head, size_type tail, ::std::index_sequence<I...> index) {
+    destroy_columns(columns_, head, tail, index);
+  }
+
+  template <size_t... I>
+  value_type row_value(size_type ind, ::std::index_sequence<I...>) const {
+    return value_type(::std::get<I>(columns_)[ind]...);
+  }
+  template <size_t... I>
+  void assign_row(size_type ind, value_type const& values, ::std::index_sequence<I...>) {
+    int expand[] = { 0, (::std::get<I>(columns_)[ind] = ::std::get<I>(values), 0)... };
+    (void)expand;
+  }
+  template <size_t... I>
+  void push_back_tuple(value_type const& values, ::std::index_sequence<I...>) {
+    push_back(::std::get<I>(values)...);
+  }
+};
+
+template <typename... Fields>
+inline void swap(soa_vector<Fields...>& a, soa_vector<Fields...>& b) noexcept {
+  a.swap(b);
+}
+
+/* soa_vector __type_traits */
+template <typename... Fields>
+struct __type_traits<soa_vector<Fields...>> {
+  using has_trivial_default_ctor = ::lem::__false_tag;
+  using has_trivial_copy_ctor = ::lem::__false_tag;
+  using has_trivial_assignment_oprtr = ::lem::__false_tag;
+  using has_trivial_dtor = ::lem::__false_tag;
+  using is_POD_type = ::lem::__false_tag;
+};
+/* end __type_traits */
+} /* end lem */
+
+#endif /* LEMSTL_LEM_SOA_VECTOR_H_ */
@@ -0,0 +1,561 @@
+// Sequential containers growing by chunks, without relocation;
+#ifndef LEMSTL_LEM_STABLE_VECTOR_H_
+#define LEMSTL_LEM_STABLE_VECTOR_H_
+
+#include <cstddef> // for size_t and std::ptrdiff_t;
+#include <initializer_list> // for std::initializer_list
+#if defined(_MSC_VER) && defined(_M_X64)
+  #include <intrin.h> // for _BitScanReverse64();
+#endif
+
+#include "../lem_memory"
+#include "../lem_iterator"
+#include "../lem_exception"
+#include "../lem_type_traits" // for __type_traits;
+
+/* NOTICE ON try-catch BLOCKS FOR CONTAINERS */
+// See lem_vector.h. The same commit or rollback pattern is used here.
+
+namespace lem {
+/* EM NOTE: chunk geometry */
+// Chunk k holds B * 2^k elements, B = 2^log_first, so the chunks are
+//
+//   | chunk 0: B | chunk 1: 2B | chunk 2: 4B | ...
+//
+// and chunk k starts at index B * (2^k - 1). For p = ind + B,
+// the chunk of ind is floor(log2(p)) - log_first, and the offset in it
+// is p without its highest bit, i.e. indexing is a bit scan and 2 subtractions.
+//
+// k chunks hold B * (2^k - 1) elements, so at most half of the capacity is unused,
+// as for vector with growth factor 2, but nothing is ever copied to grow.
+
+// floor(log2(n)), n should not be 0;
+inline size_t __floor_log2(size_t n) {
+#if defined(__GNUC__) || defined(__clang__)
+  return sizeof(unsigned long long) * 8 - 1 - size_t(__builtin_clzll(n));
+#elif defined(_MSC_VER) && defined(_M_X64)
+  unsigned long index = 0;
+  _BitScanReverse64(&index, n);
+  return size_t(index);
+#else
+  size_t k = 0;
+  for (; n > 1; n >>= 1) {
+    ++k;
+  }
+  return k;
+#endif
+}
+constexpr size_t __static_log2(size_t n) {
+  return n > 1 ? 1 + __static_log2(n >> 1) : 0;
+}
+inline size_t __chunk_of(size_t ind, size_t log_first) {
+  return ::lem::__floor_log2(ind + (size_t(1) << log_first)) - log_first;
+}
+inline size_t __chunk_offset(size_t ind, size_t log_first) {
+  size_t pos = ind + (size_t(1) << log_first);
+  return pos - (size_t(1) << ::lem::__floor_log2(pos));
+}
+/* end chunk geometry */
+
+template <typename DataType, typename PointerType, typename ReferenceType, size_t FirstChunk>
+struct __stable_vector_iterator {
+  using iterator_category   = ::lem::random_access_iterator_tag;
+  using value_type          = DataType;
+  using difference_type     = ptrdiff_t;
+  using pointer_type        = PointerType;
+  using reference_type      = ReferenceType;
+
+  using size_type           = size_t;
+
+  using self                = __stable_vector_iterator<DataType, PointerType, ReferenceType, FirstChunk>;
+  using chunk_pointer       = DataType**;
+
+  static constexpr size_type kLogFirst = ::lem::__static_log2(FirstChunk);
+
+  chunk_pointer chunk_;
+  value_type* cur_;
+  value_type* head_; // the address that chunk_ points to;
+  value_type* tail_; // head_ + chunk size;
+
+  __stable_vector_iterator(void) : chunk_(nullptr), cur_(nullptr), head_(nullptr), tail_(nullptr) {}
+  __stable_vector_iterator(chunk_pointer chunk, size_type offset, size_type chunk_size) {
+    set_node(chunk, chunk_size);
+    cur_ = head_ + offset;
+  }
+
+  // the index of the element in the container;
+  // EM NOTE: chunk k starts at B * (2^k - 1), i.e. its size minus B.
+  difference_type index(void) const {
+    return (tail_ - head_) - difference_type(FirstChunk) + (cur_ - head_);
+  }
+
+  void set_node(chunk_pointer new_chunk, size_type chunk_size) {
+    chunk_ = new_chunk;
+    head_ = *new_chunk;
+    tail_ = head_ + chunk_size;
+
+    return;
+  }
+
+  // dereference;
+  reference_type operator*(void) const {
+    return *cur_;
+  }
+  // member access;
+  pointer_type operator->(void) const {
+    return &(operator*());
+  }
+
+  // difference;
+  difference_type operator-(self const& other) const {
+    return index() - other.index();
+  }
+
+  /* EM NOTE */
+  // As for deque, the container keeps the chunk after its last element allocated,
+  // so the iterator can step into the next chunk when the current one ends.
+
+  // incre;
+  self& operator++(void) {
+    ++cur_;
+
+    if (cur_ == tail_) { // if chunk overflow;
+      set_node(chunk_ + 1, size_type(tail_ - head_) * 2);
+      cur_ = head_;
+    }
+
+    return *this;
+  }
+  self operator++(int) {
+    self cache = *this;
+    ++(*this);
+
+    return cache;
+  }
+  // decre;
+  self& operator--(void) {
+    if (cur_ == head_) {
+      set_node(chunk_ - 1, size_type(tail_ - head_) / 2);
+      cur_ = tail_;
+    }
+
+    --cur_;
+
+    return *this;
+  }
+  self operator--(int) {
+    self cache = *this;
+    --(*this);
+
+    return cache;
+  }
+
+  // random access;
+  self& operator+=(difference_type n) {
+    difference_type offset = n + (cur_ - head_);
+
+    if (offset >= 0 && offset < tail_ - head_) {
+      // The iterator stays in the same chunk after movement.
+      cur_ += n;
+    }
+    else { // The iterator moves to a new chunk;
+      size_type ind = size_type(index() + n);
+      chunk_pointer first_chunk = chunk_ - (::lem::__floor_log2(size_type(tail_ - head_)) - kLogFirst);
+      size_type chunk = ::lem::__chunk_of(ind, kLogFirst);
+
+      set_node(first_chunk + chunk, FirstChunk << chunk);
+      cur_ = head_ + ::lem::__chunk_offset(ind, kLogFirst);
+    }
+
+    return *this;
+  }
+  self& operator-=(difference_type n) {
+    return operator+=(-n);
+  }
+  self operator+(difference_type n) const {
+    self cache = *this;
+
+    return cache += n;
+  }
+  self operator-(difference_type n) const {
+    self cache = *this;
+
+    return cache -= n;
+  }
+
+  reference_type operator[](difference_type n) const {
+    return *(*this + n);
+  }
+
+  // comparison operator;
+  bool operator==(self const& other) const { // value equivalence;
+    return cur_ == other.cur_;
+  }
+  bool operator!=(self const& other) const { // value equivalence;
+    return cur_ != other.cur_;
+  }
+  bool operator<(self const& other) const { // iterator index comparison;
+    return (chunk_ == other.chunk_) ? (cur_ < other.cur_) : (chunk_ < other.chunk_);
+  }
+  bool operator<=(self const& other) const { // iterator index comparison;
+    return *this < other || *this == other;
+  }
+  bool operator>(self const& other) const { // iterator index comparison;
+    return !(*this <= other);
+  }
+  bool operator>=(self const& other) const { // iterator index comparison;
+    return !(*this < other);
+  }
+};
+
+// the chunks are the segments;
+template <typename DataType, typename PointerType, typename ReferenceType, size_t FirstChunk>
+struct __segmented_iterator_traits<__stable_vector_iterator<DataType, PointerType, ReferenceType, FirstChunk>> {
+  using iterator        = __stable_vector_iterator<DataType, PointerType, ReferenceType, FirstChunk>;
+
+  using is_segmented    = __true_tag;
+  using local_iterator  = DataType*;
+
+  static local_iterator local(iterator const& iter) {
+    return iter.cur_;
+  }
+  static local_iterator segment_end(iterator const& iter) {
+    return iter.tail_;
+  }
+  static void next_segment(iterator& iter) {
+    iter.set_node(iter.chunk_ + 1, size_t(iter.tail_ - iter.head_) * 2);
+    iter.cur_ = iter.head_;
+  }
+  static bool same_segment(iterator const& iter1, iterator const& iter2) {
+    return iter1.chunk_ == iter2.chunk_;
+  }
+};
+
+/* EM NOTE: stable_vector */
+// vector reallocates and copies everything when it grows, so every pointer,
+// reference and iterator to its elements is invalidated by push_back().
+// stable_vector appends a new chunk instead (see chunk geometry above):
+// elements never move, so references stay valid until the element is erased,
+// growth copies nothing, and indexing is still O(1).
+// The chunk table has a fixed size, so it never moves either.
+//
+// Elements are only contiguous inside a chunk. The iterators are segmented,
+// so for_each(), fill(), count_if(), accumulate() and reduce() process
+// a whole chunk at a time through native pointers.
+template <typename DataType, typename AllocType = ::lem::alloc, size_t FirstChunk = 16>
+class stable_vector {
+  static_assert(FirstChunk != 0 && (FirstChunk & (FirstChunk - 1)) == 0, "FirstChunk should be a power of 2. ");
+
+ public:
+  // Member types;
+  using allocator_type      = AllocType;
+
+  using iterator            = __stable_vector_iterator<DataType, DataType*, DataType&, FirstChunk>;
+  using reverse_iterator    = __stable_vector_iterator<DataType, DataType*, DataType&, FirstChunk>;
+
+  // Data type;
+  using size_type           = size_t;
+  using value_type          = DataType;
+  using diff_type           = ptrdiff_t;
+  using ptr_type            = DataType*;
+  using ref_type            = DataType&;
+
+ protected:
+  using chunk_pointer       = ptr_type*;
+
+  // memory allocation;
+  using data_allocator      = ::lem::simple_alloc<value_type, allocator_type>;
+  using table_allocator     = ::lem::simple_alloc<ptr_type, allocator_type>;
+
+  static constexpr size_type kLogFirst = ::lem::__static_log2(FirstChunk);
+  static constexpr size_type kMaxChunk = sizeof(size_type) * 8 - kLogFirst;
+
+  chunk_pointer chunks_; // table of kMaxChunk pointers, allocated with the first chunk;
+  size_type chunk_num_; // number of allocated chunks;
+  size_type size_;
+
+ public:
+  /* ctor */
+  // default ctor;
+  // ##usage: stable_vector<...> vct;
+  stable_vector(void) : chunks_(nullptr), chunk_num_(0), size_(0) {}
+
+  // ctor;
+  // ##usage: stable_vector<...> vct({...});
+  stable_vector(::std::initializer_list<DataType> init_list) : stable_vector() {
+    reserve(init_list.size());
+    try {
+      for (auto iter = init_list.begin(); iter != init_list.end(); ++iter) {
+        push_back(*iter);
+      }
+    }
+    catch (::std::exception const& e) {
+      // commit or rollback semantics;
+      clear();
+      free_storage();
+      // throw out;
+      throw e;
+    }
+  }
+  explicit stable_vector(size_type n, value_type const& value = value_type()) : stable_vector() {
+    try {
+      resize(n, value);
+    }
+    catch (::std::exception const& e) {
+      // commit or rollback semantics;
+      // resize() has destroyed its own elements;
+      free_storage();
+      // throw out;
+      throw e;
+    }
+  }
+
+  // copy ctor;
+  // the chunks of both vectors have the same sizes, so they are copied chunk by chunk;
+  // ##usage: stable_vector<...> vct(SOME_STABLE_VECTOR);
+  stable_vector(stable_vector const& other) : stable_vector() {
+    reserve(other.size());
+
+    size_type chunk = 0;
+    try {
+      for (size_type ind = 0; ind < other.size(); ++chunk) {
+        size_type len = (other.size() - ind < chunk_size(chunk)) ? other.size() - ind : chunk_size(chunk);
+        ::lem::uninitialized_copy(other.chunks_[chunk], other.chunks_[chunk] + len, chunks_[chunk]);
+        ind += len;
+      }
+    }
+    catch (::std::exception const& e) {
+      // commit or rollback semantics;
+      for (size_type done = 0; done < chunk; ++done) {
+        ::lem::destroy(chunks_[done], chunks_[done] + chunk_size(done));
+      }
+      free_storage();
+      // throw out;
+      throw e;
+    }
+
+    size_ = other.size();
+  }
+  // move ctor;
+  // ##usage: stable_vector<...> vct(std::move(SOME_STABLE_VECTOR));
+  stable_vector(stable_vector&& other) noexcept : stable_vector() {
+    swap(other);
+  }
+
+  // assignment ctor;
+  // ##usage: vct = SOME_STABLE_VECTOR;
+  stable_vector& operator=(stable_vector const& other) {
+    if (this != &other) {
+      stable_vector cache(other);
+      swap(cache);
+    }
+
+    return *this;
+  }
+  // move assignment;
+  // ##usage: vct = std::move(SOME_STABLE_VECTOR);
+  stable_vector& operator=(stable_vector&& other) noexcept {
+    if (this != &other) {
+      stable_vector cache(::std::move(other));
+      swap(cache);
+    }
+
+    return *this;
+  }
+  /* end ctor */
+
+  /* dtor */
+  ~stable_vector(void) {
+    clear();
+    free_storage();
+  }
+  /* end dtor */
+
+  /* iterators */
+  iterator begin(void) const noexcept {
+    return iterator_at(0);
+  }
+  iterator end(void) const noexcept {
+    return iterator_at(size_);
+  }
+  /* end iterators */
+
+  /* accessors */
+  ref_type operator[](size_type ind) const noexcept {
+    return chunks_[::lem::__chunk_of(ind, kLogFirst)][::lem::__chunk_offset(ind, kLogFirst)];
+  }
+  ref_type at(size_type ind) const {
+    if (ind >= size()) {
+      throw std::out_of_range("Invalid vector subscript. ");
+    }
+
+    return operator[](ind);
+  }
+  ref_type front(void) const noexcept {
+    return operator[](0);
+  }
+  ref_type back(void) const noexcept {
+    return operator[](size_ - 1);
+  }
+  /* end accessors */
+
+  /* capacity functions */
+  bool empty(void) const noexcept {
+    return size_ == 0;
+  }
+  size_type size(void) const noexcept {
+    return size_;
+  }
+  size_type capacity(void) const noexcept {
+    return FirstChunk * ((size_type(1) << chunk_num_) - 1);
+  }
+  size_type chunk_count(void) const noexcept {
+    return chunk_num_;
+  }
+  // EM NOTE: the chunk holding index req is allocated as well,
+  // so capacity() > req afterwards.
+  void reserve(size_type req) {
+    while (capacity() <= req) {
+      add_chunk();
+    }
+
+    return;
+  }
+  // release the chunks after the one holding index size();
+  void shrink_to_fit(void) {
+    size_type keep = (size_ == 0) ? 0 : ::lem::__chunk_of(size_, kLogFirst) + 1;
+    while (chunk_num_ > keep) {
+      --chunk_num_;
+      data_allocator::deallocate(chunks_[chunk_num_], chunk_size(chunk_num_));
+      chunks_[chunk_num_] = nullptr;
+    }
+    if (chunk_num_ == 0) {
+      free_storage();
+    }
+
+    return;
+  }
+  /* end capacity */
+
+  /* modifiers */
+  // EM NOTE: value may be an element of this vector, which stays in place.
+  void push_back(value_type const& value) {
+    reserve(size_ + 1);
+    ::lem::construct(&operator[](size_), value);
+    ++size_;
+
+    return;
+  }
+  void pop_back(void) {
+    if (empty()) {
+      throw lem::pop_empty_vector();
+    }
+
+    --size_;
+    ::lem::destroy(&operator[](size_));
+
+    return;
+  }
+  void resize(size_type n, value_type const& value = value_type()) {
+    if (n <= size_) {
+      destroy_range(iterator_at(n), end());
+      size_ = n;
+
+      return;
+    }
+
+    reserve(n);
+    size_type prev_size = size_;
+    try {
+      for (; size_ < n; ++size_) {
+        ::lem::construct(&operator[](size_), value);
+      }
+    }
+    catch (::std::exception const& e) {
+      // commit or rollback semantics;
+      destroy_range(iterator_at(prev_size), end());
+      size_ = prev_size;
+      // throw out;
+      throw e;
+    }
+
+    return;
+  }
+  // the chunks are kept;
+  void clear(void) {
+    destroy_range(begin(), end());
+    size_ = 0;
+
+    return;
+  }
+  void swap(stable_vector& other) noexcept {
+    ::lem::swap(chunks_, other.chunks_);
+    ::lem::swap(chunk_num_, other.chunk_num_);
+    ::lem::swap(size_, other.size_);
+
+    return;
+  }
+  /* end modifiers */
+
+ protected:
+  static size_type chunk_size(size_type chunk) {
+    return FirstChunk << chunk;
+  }
+  iterator iterator_at(size_type ind) const {
+    if (chunk_num_ == 0) {
+      return iterator();
+    }
+
+    size_type chunk = ::lem::__chunk_of(ind, kLogFirst);
+    return iterator(chunks_ + chunk, ::lem::__chunk_offset(ind, kLogFirst), chunk_size(chunk));
+  }
+  void add_chunk(void) {
+    if (chunks_ == nullptr) {
+      chunks_ = table_allocator::allocate(kMaxChunk);
+      for (size_type chunk = 0; chunk < kMaxChunk; ++chunk) {
+        chunks_[chunk] = nullptr;
+      }
+    }
+    if (chunk_num_ == kMaxChunk) {
+      throw std::length_error("stable_vector too long. ");
+    }
+
+    chunks_[chunk_num_] = data_allocator::allocate(chunk_size(chunk_num_));
+    ++chunk_num_;
+
+    return;
+  }
+  void destroy_range(iterator head, iterator tail) {
+    if (head == tail) {
+      return;
+    }
+
+    auto visit = [](ptr_type local_head, ptr_type local_tail) {
+      ::lem::destroy(local_head, local_tail);
+    };
+    ::lem::__for_each_segment(head, tail, visit);
+
+    return;
+  }
+  // release all the chunks and the table, the elements should be destroyed;
+  void free_storage(void) {
+    for (size_type chunk = 0; chunk < chunk_num_; ++chunk) {
+      data_allocator::deallocate(chunks_[chunk], chunk_size(chunk));
+    }
+    if (chunks_ != nullptr) {
+      table_allocator::deallocate(chunks_, kMaxChunk);
+    }
+    chunks_ = nullptr;
+    chunk_num_ = 0;
+
+    return;
+  }
+};
+
+template <typename DataType, typename AllocType, size_t FirstChunk>
+inline void swap(stable_vector<DataType, AllocType, FirstChunk>& a, stable_vector<DataType, AllocType, FirstChunk>& b) noexcept {
+  a.swap(b);
+}
+} /* end lem */
+
+#endif /* LEMSTL_LEM_STABLE_VECTOR_H_ */
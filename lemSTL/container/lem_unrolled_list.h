@@ -0,0 +1,810 @@
+// Unrolled linked list containers (doubly-linked nodes of small arrays);
+#ifndef LEMSTL_LEM_UNROLLED_LIST_H_
+#define LEMSTL_LEM_UNROLLED_LIST_H_
+
+#include <cstddef> // for size_t and std::ptrdiff_t;
+#include <cstring> // for memcpy();
+#include <initializer_list> // for std::initializer_list
+#include <new> // for placement new;
+#include <type_traits> // for std::enable_if and std::is_same;
+#include <utility> // for std::move();
+
+#include "../lem_memory"
+#include "../lem_iterator"
+#include "../lem_exception"
+#include "../lem_type_traits" // for __type_traits;
+#include "lem_list.h" // for __list_node_base;
+
+/* NOTICE ON try-catch BLOCKS FOR CONTAINERS */
+// See lem_list.h. The same commit or rollback pattern is used here.
+
+namespace lem {
+/* EM NOTE: unrolled_list */
+// A list node costs 2 links and, when traversed, one cache miss per element.
+// unrolled_list keeps up to K elements in each node, so traversal misses
+// once per K elements, and the links cost 16 / K bytes per element:
+//
+//      -------------------------------------------------------------------
+//      |                                                                 |
+//      v                                                                 |
+// ---------     ------------------     -------     --------------------  |
+// | head_ | --> | 3 | e0 e1 e2 . | --> | ... | --> | 2 | ek ek+1 . .  | --
+// ---------     ------------------     -------     --------------------
+//
+// 1. insert() shifts the elements behind it in the node, and splits a full node
+//    into 2 half-full ones first;
+// 2. erase() shifts the elements back, and merges the node with the next one
+//    when it is less than half full and both fit in one node;
+// 3. splice() moves whole nodes, after splitting the nodes at the ends of the range,
+//    so it costs O(K) plus O(number of nodes) to count the moved elements;
+// 4. merge() and sort() move the elements, not the nodes.
+//
+// Elements move inside and between nodes, so insert() and erase()
+// invalidate the iterators to the node they change (and the next one, for erase()),
+// and splice() invalidates the iterators to the nodes it splits at the ends of the range,
+// in both lists.
+// Moving an element is assumed not to throw.
+constexpr size_t __unrolled_node_capacity(size_t datasize) {
+  return (256 / datasize >= 4) ? 256 / datasize : 4;
+}
+
+struct __unrolled_node_base : __list_node_base {
+  size_t count_ = 0; // number of elements in the node, 0 only for the header;
+};
+template <typename DataType, size_t K>
+struct __unrolled_node : __unrolled_node_base {
+  alignas(DataType) unsigned char storage_[K * sizeof(DataType)];
+
+  DataType* elems(void) noexcept {
+    return reinterpret_cast<DataType*>(storage_);
+  }
+};
+
+/* __unrolled_relocate() */
+// move-construct n elements from src to the uninitialized dst, and destroy them in src;
+template <typename DataType>
+inline void __unrolled_relocate(DataType* src, size_t n, DataType* dst, ::lem::__false_tag) {
+  for (size_t ind = 0; ind < n; ++ind) {
+    ::new (static_cast<void*>(dst + ind)) DataType(::std::move(src[ind]));
+    ::lem::destroy(src + ind);
+  }
+}
+template <typename DataType>
+inline void __unrolled_relocate(DataType* src, size_t n, DataType* dst, ::lem::__true_tag) {
+  if (n != 0) {
+    ::std::memcpy(dst, src, n * sizeof(DataType));
+  }
+}
+template <typename DataType>
+inline void __unrolled_relocate(DataType* src, size_t n, DataType* dst) {
+  using is_POD = typename __type_traits<DataType>::is_POD_type;
+  ::lem::__unrolled_relocate(src, n, dst, is_POD());
+}
+/* end __unrolled_relocate() */
+
+template <typename DataType, typename PointerType, typename ReferenceType, size_t K>
+struct __unrolled_list_iterator {
+  using iterator_category     = ::lem::bidirectional_iterator_tag;
+  using value_type            = DataType;
+  using difference_type       = ptrdiff_t;
+  using pointer_type          = PointerType;
+  using reference_type        = ReferenceType;
+
+  using self                  = __unrolled_list_iterator<DataType, PointerType, ReferenceType, K>;
+  using iterator              = __unrolled_list_iterator<DataType, DataType*, DataType&, K>;
+  using node_pointer          = __unrolled_node<DataType, K>*;
+  using link_pointer          = __unrolled_node_base*;
+
+  // data;
+  link_pointer node_;
+  size_t ind_; // index of the element in node_, 0 for end();
+
+  // ctor;
+  __unrolled_list_iterator(void) : node_(nullptr), ind_(0) {}
+  __unrolled_list_iterator(link_pointer node, size_t ind) : node_(node), ind_(ind) {}
+
+  __unrolled_list_iterator(self const&) = default;
+  // iterator to const_iterator;
+  template <typename Iter, typename = typename ::std::enable_if<::std::is_same<Iter, iterator>::value && !::std::is_same<Iter, self>::value>::type>
+  __unrolled_list_iterator(Iter const& iter) : node_(iter.node_), ind_(iter.ind_) {}
+
+  self& operator=(self const&) = default;
+
+  // equality;
+  bool operator==(self const& iter) const {
+    return node_ == iter.node_ && ind_ == iter.ind_;
+  }
+  bool operator!=(self const& iter) const {
+    return !(*this == iter);
+  }
+
+  // dereference;
+  reference_type operator*(void) const {
+    return static_cast<node_pointer>(node_)->elems()[ind_];
+  }
+  // member access;
+  pointer_type operator->(void) const {
+    return &(operator*());
+  }
+
+  // incre and decre;
+  // prefix incre;
+  self& operator++(void) {
+    if (++ind_ == node_->count_) {
+      node_ = static_cast<link_pointer>(node_->next_);
+      ind_ = 0;
+    }
+    return *this;
+  }
+  // postfix incre;
+  self operator++(int) {
+    self cache = *this;
+    ++(*this);
+    return cache;
+  }
+  // prefix decre;
+  self& operator--(void) {
+    if (ind_ == 0) {
+      node_ = static_cast<link_pointer>(node_->pred_);
+      ind_ = node_->count_;
+    }
+    --ind_;
+    return *this;
+  }
+  // postfix decre;
+  self operator--(int) {
+    self cache = *this;
+    --(*this);
+    return cache;
+  }
+};
+
+// the nodes are the segments, and the header is an empty one;
+template <typename DataType, typename PointerType, typename ReferenceType, size_t K>
+struct __segmented_iterator_traits<__unrolled_list_iterator<DataType, PointerType, ReferenceType, K>> {
+  using iterator        = __unrolled_list_iterator<DataType, PointerType, ReferenceType, K>;
+
+  using is_segmented    = __true_tag;
+  using local_iterator  = DataType*;
+
+  static local_iterator local(iterator const& iter) {
+    if (iter.node_->count_ == 0) {
+      return nullptr;
+    }
+    return static_cast<typename iterator::node_pointer>(iter.node_)->elems() + iter.ind_;
+  }
+  static local_iterator segment_end(iterator const& iter) {
+    return static_cast<typename iterator::node_pointer>(iter.node_)->elems() + iter.node_->count_;
+  }
+  static void next_segment(iterator& iter) {
+    iter.node_ = static_cast<typename iterator::link_pointer>(iter.node_->next_);
+    iter.ind_ = 0;
+  }
+  static bool same_segment(iterator const& iter1, iterator const& iter2) {
+    return iter1.node_ == iter2.node_;
+  }
+};
+
+template <typename DataType, size_t K = ::lem::__unrolled_node_capacity(sizeof(DataType)), typename AllocType = ::lem::alloc>
+class unrolled_list {
+  static_assert(K >= 2, "A node of unrolled_list should hold at least 2 elements. ");
+
+ public:
+  using allocator_type      = AllocType;
+
+  // iterator traits;
+  using iterator            = __unrolled_list_iterator<DataType, DataType*, DataType&, K>;
+  using reverse_iterator    = __unrolled_list_iterator<DataType, DataType*, DataType&, K>;
+
+  // data type;
+  using size_type           = size_t;
+  using value_type          = DataType;
+  using diff_type           = ptrdiff_t;
+  using ptr_type            = DataType*;
+  using ref_type            = DataType&;
+  using node_type           = ::lem::__unrolled_node<value_type, K>;
+  using node_pointer        = ::lem::__unrolled_node<value_type, K>*;
+  using link_pointer        = ::lem::__unrolled_node_base*;
+
+  static constexpr size_type kNodeCapacity = K;
+
+ protected:
+  using node_allocator      = ::lem::simple_alloc<node_type, allocator_type>;
+  using data_allocator      = ::lem::simple_alloc<value_type, allocator_type>;
+
+  static constexpr size_type kSortRun = 16; // elements sorted by insertion before merging;
+
+  // data;
+  __unrolled_node_base head_; // empty header node, as for list;
+  size_type size_;
+
+ public:
+  /* ctor */
+  // default ctor;
+  // ##usage: unrolled_list<...> lst;
+  unrolled_list(void) : size_(0) {
+    reset_header();
+  }
+
+  // ctor;
+  // ##usage: unrolled_list<...> lst({...});
+  unrolled_list(::std::initializer_list<value_type> init_list) : unrolled_list() {
+    for (auto iter = init_list.begin(); iter != init_list.end(); ++iter) {
+      push_back(*iter);
+    }
+  }
+
+  // copy ctor;
+  // The copy is packed, i.e. every node but the last is full;
+  // ##usage: unrolled_list<...> lst(SOME_UNROLLED_LIST);
+  unrolled_list(unrolled_list const& other) : unrolled_list() {
+    for (iterator iter = other.begin(); iter != other.end(); ++iter) {
+      push_back(*iter);
+    }
+  }
+  // move ctor;
+  // ##usage: unrolled_list<...> lst(std::move(SOME_UNROLLED_LIST));
+  unrolled_list(unrolled_list&& other) noexcept : unrolled_list() {
+    swap(other);
+  }
+
+  // assignment ctor;
+  // ##usage: lst = SOME_UNROLLED_LIST;
+  unrolled_list& operator=(unrolled_list const& other) {
+    if (this != &other) {
+      unrolled_list cache(other);
+      swap(cache);
+    }
+
+    return *this;
+  }
+  // move assignment;
+  // ##usage: lst = std::move(SOME_UNROLLED_LIST);
+  unrolled_list& operator=(unrolled_list&& other) noexcept {
+    if (this != &other) {
+      clear();
+      swap(other);
+    }
+
+    return *this;
+  }
+  /* end ctor */
+
+  /* dtor */
+  ~unrolled_list(void) {
+    clear();
+  }
+  /* end dtor */
+
+  /* iterators */
+  iterator begin(void) const noexcept {
+    return iterator(static_cast<link_pointer>(head_.next_), 0);
+  }
+  iterator end(void) const noexcept {
+    return iterator(header(), 0);
+  }
+  /* end iterators */
+
+  /* accessors */
+  ref_type front(void) const noexcept {
+    return *begin();
+  }
+  ref_type back(void) const noexcept {
+    return *(--end());
+  }
+  /* end accessors */
+
+  /* capacity */
+  bool empty(void) const noexcept {
+    return size_ == 0;
+  }
+  size_type size(void) const noexcept {
+    return size_;
+  }
+  /* end capacity */
+
+  /* modifiers */
+  iterator insert(iterator iter, value_type const& value) {
+    link_pointer node = iter.node_;
+    size_type ind = iter.ind_;
+
+    if (node == header()) { // append to the last node, or to a new one;
+      node = static_cast<link_pointer>(head_.pred_);
+      if (node == header() || node->count_ == K) {
+        node = create_node(header());
+        try {
+          ::lem::construct(elems_of(node), value);
+        }
+        catch (::std::exception const& e) {
+          // commit or rollback semantics;
+          free_node(node);
+          // throw out;
+          throw e;
+        }
+        node->count_ = 1;
+        ++size_;
+
+        return iterator(node, 0);
+      }
+      ind = node->count_;
+    }
+    else if (node->count_ == K) { // split the full node into halves;
+      link_pointer upper = split(node, K / 2);
+      if (ind > K / 2) {
+        node = upper;
+        ind -= K / 2;
+      }
+    }
+
+    // Now node has room;
+    ptr_type elems = elems_of(node);
+    size_type count = node->count_;
+    if (ind == count) {
+      ::lem::construct(elems + count, value);
+    }
+    else {
+      // value may be an element of the node, so it is copied before shifting;
+      value_type cache(value);
+      ::new (static_cast<void*>(elems + count)) value_type(::std::move(elems[count - 1]));
+      for (size_type cur = count - 1; cur > ind; --cur) {
+        elems[cur] = ::std::move(elems[cur - 1]);
+      }
+      elems[ind] = ::std::move(cache);
+    }
+    ++node->count_;
+    ++size_;
+
+    return iterator(node, ind);
+  }
+  void push_back(value_type const& value) {
+    insert(end(), value);
+
+    return;
+  }
+  void push_front(value_type const& value) {
+    insert(begin(), value);
+
+    return;
+  }
+
+  iterator erase(iterator iter) {
+    // protect list header;
+    if (iter == end()) {
+      throw ::lem::del_header();
+    }
+
+    link_pointer node = iter.node_;
+    size_type ind = iter.ind_;
+    ptr_type elems = elems_of(node);
+    size_type count = node->count_;
+
+    for (size_type cur = ind; cur + 1 < count; ++cur) {
+      elems[cur] = ::std::move(elems[cur + 1]);
+    }
+    ::lem::destroy(elems + count - 1);
+    --node->count_;
+    --size_;
+
+    if (node->count_ == 0) {
+      link_pointer next = static_cast<link_pointer>(node->next_);
+      free_node(node);
+
+      return iterator(next, 0);
+    }
+
+    merge_next(node);
+
+    return (ind < node->count_) ? iterator(node, ind) : iterator(static_cast<link_pointer>(node->next_), 0);
+  }
+  void pop_front(void) {
+    erase(begin());
+
+    return;
+  }
+  void pop_back(void) {
+    erase(--end());
+
+    return;
+  }
+
+  // The kept elements are moved to the front, and the rest is cut off in one go;
+  size_type remove(value_type const& value) {
+    return remove_if([&value](value_type const& data) -> bool {
+      return data == value;
+    });
+  }
+  template <typename UnaryPredicate>
+  size_type remove_if(UnaryPredicate pred) {
+    iterator write = begin();
+    for (iterator read = begin(); read != end(); ++read) {
+      if (!pred(*read)) {
+        if (write != read) {
+          *write = ::std::move(*read);
+        }
+        ++write;
+      }
+    }
+
+    size_type prev_size = size_;
+    truncate(write);
+
+    return prev_size - size_;
+  }
+
+  void clear(void) {
+    truncate(begin());
+
+    return;
+  }
+
+  size_type unique(void) {
+    return unique([](value_type const& a, value_type const& b) -> bool {
+      return a == b;
+    });
+  }
+  // pred(a, b) tells whether b is a duplicate of the kept element a;
+  template <typename BinaryPredicate>
+  size_type unique(BinaryPredicate pred) {
+    if (empty()) {
+      return 0;
+    }
+
+    iterator kept = begin();
+    iterator read = begin();
+    for (++read; read != end(); ++read) {
+      if (!pred(*kept, *read)) {
+        ++kept;
+        if (kept != read) {
+          *kept = ::std::move(*read);
+        }
+      }
+    }
+
+    size_type prev_size = size_;
+    truncate(++kept);
+
+    return prev_size - size_;
+  }
+
+  void splice(iterator const iter, unrolled_list& lst) {
+    if (this == &lst) {
+      throw ::lem::self_splice();
+    }
+    if (lst.empty()) {
+      return;
+    }
+
+    transfer(split_at(iter), static_cast<link_pointer>(lst.head_.next_), lst.header());
+    size_ += lst.size_;
+    lst.size_ = 0;
+
+    return;
+  }
+  // a single element is copied over, not its node;
+  void splice(iterator const iter, unrolled_list& lst, iterator const head) {
+    if (this == &lst) {
+      throw ::lem::self_splice("Element self-splicing. ");
+    }
+
+    insert(iter, *head);
+    lst.erase(head);
+
+    return;
+  }
+  void splice(iterator const iter, unrolled_list& lst, iterator const head, iterator const tail) {
+    if (this == &lst) {
+      throw ::lem::self_splice("Interval self-splicing. ");
+    }
+    if (head == tail) {
+      return;
+    }
+
+    // split tail first, so that head stays valid;
+    link_pointer last = lst.split_at(tail);
+    link_pointer first = lst.split_at(head);
+    size_type count = 0;
+    for (link_pointer node = first; node != last; node = static_cast<link_pointer>(node->next_)) {
+      count += node->count_;
+    }
+
+    transfer(split_at(iter), first, last);
+    size_ += count;
+    lst.size_ -= count;
+
+    return;
+  }
+
+  // merge two sorted lists;
+  // Lists should already been sorted in ascending order.
+  // The elements are moved into new packed nodes;
+  void merge(unrolled_list& other) {
+    if (this == &other) {
+      return;
+    }
+
+    unrolled_list result;
+    iterator iter = begin();
+    iterator jter = other.begin();
+    while (iter != end() && jter != other.end()) {
+      if (*iter > *jter) {
+        result.append_moved(*(jter++));
+      }
+      else {
+        result.append_moved(*(iter++));
+      }
+    }
+    for (; iter != end(); ++iter) {
+      result.append_moved(*iter);
+    }
+    for (; jter != other.end(); ++jter) {
+      result.append_moved(*jter);
+    }
+
+    clear();
+    other.clear();
+    swap(result);
+
+    return;
+  }
+
+  void reverse(void) {
+    if (size_ <= 1) {
+      return;
+    }
+
+    iterator head = begin();
+    iterator tail = --end();
+    for (size_type count = size_ / 2; count != 0; --count) {
+      ::lem::swap(*head, *tail);
+      ++head;
+      --tail;
+    }
+
+    return;
+  }
+
+  // exchange the links of the header nodes, O(1);
+  void swap(unrolled_list& other) noexcept {
+    ::lem::swap(head_, other.head_);
+    ::lem::swap(size_, other.size_);
+    relink_header();
+    other.relink_header();
+
+    return;
+  }
+  /* end modifiers */
+
+  /* sort (impl. merge sort) */
+  // EM NOTE: the elements are moved to one array, sorted there by a bottom-up
+  // merge sort between 2 arrays, and moved back into the same nodes, so the nodes are kept
+  // and no link is followed while sorting.
+  // As list::sort(), the sort is stable and compares by operator> only, as merge() does.
+  void sort(void) {
+    if (size_ <= 1) {
+      return;
+    }
+
+    ptr_type buffer = data_allocator::allocate(2 * size_);
+    ptr_type from = buffer; // holds the elements between the passes;
+    ptr_type to = buffer + size_;
+    gather(from);
+    try {
+      sort_runs(from, size_);
+      for (size_type width = kSortRun; width < size_; width *= 2) {
+        ::lem::swap(from, to);
+        merge_pass(to, from, size_, width);
+      }
+    }
+    catch (::std::exception const& e) {
+      // commit or rollback semantics;
+      // the elements are all in from, in some order;
+      scatter(from);
+      data_allocator::deallocate(buffer, 2 * size_);
+      // throw out;
+      throw e;
+    }
+    scatter(from);
+    data_allocator::deallocate(buffer, 2 * size_);
+
+    return;
+  }
+  /* end sort */
+
+ protected:
+  link_pointer header(void) const noexcept {
+    return const_cast<link_pointer>(&head_);
+  }
+  void reset_header(void) noexcept {
+    head_.next_ = header();
+    head_.pred_ = header();
+    head_.count_ = 0;
+  }
+  // point the neighbours of a moved header back to it;
+  void relink_header(void) noexcept {
+    if (size_ == 0) {
+      reset_header();
+    }
+    else {
+      head_.next_->pred_ = header();
+      head_.pred_->next_ = header();
+    }
+  }
+  static ptr_type elems_of(link_pointer node) noexcept {
+    return static_cast<node_pointer>(node)->elems();
+  }
+
+  // new empty node before pos;
+  link_pointer create_node(link_pointer pos) {
+    link_pointer node = node_allocator::allocate();
+    node->count_ = 0;
+    node->next_ = pos;
+    node->pred_ = pos->pred_;
+    pos->pred_->next_ = node;
+    pos->pred_ = node;
+
+    return node;
+  }
+  // unlink and deallocate a node whose elements are destroyed;
+  void free_node(link_pointer node) noexcept {
+    node->pred_->next_ = node->next_;
+    node->next_->pred_ = node->pred_;
+    node_allocator::deallocate(static_cast<node_pointer>(node), 1);
+  }
+
+  // move elements [at, count) of node to a new node after it, and return the new node;
+  link_pointer split(link_pointer node, size_type at) {
+    link_pointer upper = create_node(static_cast<link_pointer>(node->next_));
+    ::lem::__unrolled_relocate(elems_of(node) + at, node->count_ - at, elems_of(upper));
+    upper->count_ = node->count_ - at;
+    node->count_ = at;
+
+    return upper;
+  }
+  // the node starting at iter, splitting the node of iter if needed;
+  link_pointer split_at(iterator iter) {
+    return (iter.ind_ == 0) ? iter.node_ : split(iter.node_, iter.ind_);
+  }
+  // take the elements of the next node if both fit in node, and node is less than half full;
+  void merge_next(link_pointer node) {
+    link_pointer next = static_cast<link_pointer>(node->next_);
+    if (next == header() || node->count_ >= K / 2 || node->count_ + next->count_ > K) {
+      return;
+    }
+
+    ::lem::__unrolled_relocate(elems_of(next), next->count_, elems_of(node) + node->count_);
+    node->count_ += next->count_;
+    free_node(next);
+
+    return;
+  }
+  // move the nodes [first, last) before pos, see list::transfer();
+  void transfer(link_pointer pos, link_pointer first, link_pointer last) noexcept {
+    __list_node_base* first_pred = first->pred_;
+    __list_node_base* last_pred = last->pred_;
+
+    first_pred->next_ = last;
+    last->pred_ = first_pred;
+
+    pos->pred_->next_ = first;
+    first->pred_ = pos->pred_;
+    last_pred->next_ = pos;
+    pos->pred_ = last_pred;
+
+    return;
+  }
+  // destroy the elements from iter to the end, and free the emptied nodes;
+  void truncate(iterator iter) noexcept {
+    link_pointer node = iter.node_;
+    if (iter.ind_ != 0) {
+      ::lem::destroy(elems_of(node) + iter.ind_, elems_of(node) + node->count_);
+      size_ -= node->count_ - iter.ind_;
+      node->count_ = iter.ind_;
+      node = static_cast<link_pointer>(node->next_);
+    }
+    while (node != header()) {
+      link_pointer next = static_cast<link_pointer>(node->next_);
+      ::lem::destroy(elems_of(node), elems_of(node) + node->count_);
+      size_ -= node->count_;
+      free_node(node);
+      node = next;
+    }
+
+    return;
+  }
+  // push_back() by moving value;
+  void append_moved(value_type& value) {
+    link_pointer node = static_cast<link_pointer>(head_.pred_);
+    if (node == header() || node->count_ == K) {
+      node = create_node(header());
+    }
+
+    ::new (static_cast<void*>(elems_of(node) + node->count_)) value_type(::std::move(value));
+    ++node->count_;
+    ++size_;
+
+    return;
+  }
+  // move the elements into the uninitialized buffer in order, and back;
+  void gather(ptr_type buffer) noexcept {
+    for (link_pointer node = static_cast<link_pointer>(head_.next_); node != header(); node = static_cast<link_pointer>(node->next_)) {
+      ::lem::__unrolled_relocate(elems_of(node), node->count_, buffer);
+      buffer += node->count_;
+    }
+  }
+  void scatter(ptr_type buffer) noexcept {
+    for (link_pointer node = static_cast<link_pointer>(head_.next_); node != header(); node = static_cast<link_pointer>(node->next_)) {
+      ::lem::__unrolled_relocate(buffer, node->count_, elems_of(node));
+      buffer += node->count_;
+    }
+  }
+
+  // sort each run of kSortRun elements by insertion, by swaps only,
+  // so that a comparison which throws leaves all the elements in buffer;
+  static void sort_runs(ptr_type buffer, size_type n) {
+    for (size_type head = 0; head < n; head += kSortRun) {
+      size_type tail = (n - head < kSortRun) ? n : head + kSortRun;
+      for (size_type cur = head + 1; cur < tail; ++cur) {
+        for (size_type ind = cur; ind > head && buffer[ind - 1] > buffer[ind]; --ind) {
+          ::lem::swap(buffer[ind - 1], buffer[ind]);
+        }
+      }
+    }
+  }
+  // relocate the sorted runs of width elements in src to dst, merged by pairs;
+  // on a tie the element of the left run goes first, which keeps the sort stable.
+  // If a comparison throws, the rest of src is still relocated to dst;
+  static void merge_pass(ptr_type src, ptr_type dst, size_type n, size_type width) {
+    ptr_type tail = src + n;
+    ptr_type left = src;
+    ptr_type left_end = src;
+    ptr_type right = src;
+    ptr_type out = dst;
+    try {
+      for (; left != tail; left = right) {
+        left_end = (size_type(tail - left) < width) ? tail : left + width;
+        right = left_end;
+        ptr_type right_end = (size_type(tail - right) < width) ? tail : right + width;
+        while (left != left_end && right != right_end) {
+          if (*left > *right) {
+            ::lem::__unrolled_relocate(right++, 1, out++);
+          }
+          else {
+            ::lem::__unrolled_relocate(left++, 1, out++);
+          }
+        }
+        ::lem::__unrolled_relocate(left, size_type(left_end - left), out);
+        out += left_end - left;
+        ::lem::__unrolled_relocate(right, size_type(right_end - right), out);
+        out += right_end - right;
+        right = right_end;
+      }
+    }
+    catch (::std::exception const& e) {
+      // commit or rollback semantics;
+      ::lem::__unrolled_relocate(left, size_type(left_end - left), out);
+      out += left_end - left;
+      ::lem::__unrolled_relocate(right, size_type(tail - right), out);
+      // throw out;
+      throw e;
+    }
+  }
+};
+
+template <typename DataType, size_t K, typename AllocType>
+inline void swap(unrolled_list<DataType, K, AllocType>& a, unrolled_list<DataType, K, AllocType>& b) noexcept {
+  a.swap(b);
+}
+
+/* unrolled_list __type_traits */
+template <typename DataType, size_t K, typename AllocType>
+struct __type_traits<unrolled_list<DataType, K, AllocType>> {
+  using has_trivial_default_ctor = ::lem::__false_tag;
+  using has_trivial_copy_ctor = ::lem::__false_tag;
+  using has_trivial_assignment_oprtr = ::lem::__false_tag;
+  using has_trivial_dtor = ::lem::__false_tag;
+  using is_POD_type = ::lem::__false_tag;
+};
+/* end __type_traits */
+} /* end lem */
+
+#endif /* LEMSTL_LEM_UNROLLED_LIST_H_ */
@@ -12,6 +12,7 @@
 
 #include <cstddef> // for std::ptrdiff_t;
 #include <initializer_list> // for std::initializer_list
+#include <utility> // for std::move();
 
 #include "../lem_memory"
 #include "../lem_iterator"
@@ -45,8 +46,34 @@
 // to let the user know this construction failure. 
 
 namespace lem {
+/* growth policies */
+// GrowthPolicy::grow(capacity, required) gives the new capacity (>= required)
+// when an insertion needs more than capacity elements.
+// EM NOTE: a constant factor keeps push_back() amortized O(1).
+// Factor 2 reallocates the least often, while factor 1.5 lets the allocator
+// reuse the freed blocks (the sum of the previous blocks eventually exceeds
+// the next one), and wastes at most a third of the memory instead of a half.
+// Exact-fit never wastes memory, but makes every growth O(n),
+// so it only fits vectors filled by a known number of insertions.
+struct growth_factor_2 {
+  static size_t grow(size_t capacity, size_t required) {
+    return (2 * capacity > required ? 2 * capacity : required);
+  }
+};
+struct growth_factor_1_5 {
+  static size_t grow(size_t capacity, size_t required) {
+    return (capacity + capacity / 2 > required ? capacity + capacity / 2 : required);
+  }
+};
+struct growth_exact {
+  static size_t grow(size_t /* capacity */, size_t required) {
+    return required;
+  }
+};
+/* end growth policies */
+
 // See declarations at https://en.cppreference.com/w/cpp/container/vector;
-template <typename DataType, typename AllocType = alloc>
+template <typename DataType, typename AllocType = alloc, typename GrowthPolicy = growth_factor_2>
 class vector {
  public:
   // Member types;
@@ -140,13 +167,59 @@ class vector {
   // ##usage: vector<...> vct = SOME_VECTOR;
   //  Here SOME_VECTOR will not be considered as ARGUMENT for copy ctor to construct a temp object,
   //  instead vct is directly constructed by copy ctor which is exactly like vct(SOME_VECTOR).
-  /* vector(vector<DataType, AllocType> const&) {} */ // deep copy for specific DataType;
+  // EM NOTE: the memory is allocated once with the exact size,
+  // and uninitialized_copy() copies trivial types by a single memmove.
+  vector(vector const& other) {
+    size_type n = other.size();
+    mem_head_ = data_allocator::allocate(n);
+    try {
+      ::lem::uninitialized_copy(other.begin(), other.end(), mem_head_);
+    }
+    catch (::std::exception const& e) {
+      // commit or rollback semantics;
+      ::lem::destroy(mem_head_, mem_head_ + n);
+      data_allocator::deallocate(mem_head_, n);
+      // throw out;
+      throw e;
+    }
+
+    // set memory tags;
+    data_tail_ = mem_head_ + n;
+    mem_tail_ = data_tail_;
+  }
+
+  // move ctor;
+  // The memory of other is taken over, and other is left empty;
+  // ##usage: vector<...> vct(std::move(SOME_VECTOR));
+  vector(vector&& other) noexcept
+      : mem_head_(other.mem_head_), data_tail_(other.data_tail_), mem_tail_(other.mem_tail_) {
+    other.mem_head_ = nullptr;
+    other.data_tail_ = nullptr;
+    other.mem_tail_ = nullptr;
+  }
 
   // assignment ctor;
   // deep copy for specific DataType;
   // Notice that assignment ctor is used to change data of initialized objects.
+  // The memory is reused if the capacity is large enough, see assign();
   // ##usage: vct = SOME_VECTOR;
-  /* vector<DataType, AllocType> operator=(vector<DataType, AllocType>) {} */
+  vector& operator=(vector const& other) {
+    if (this != &other) {
+      assign(other.begin(), other.end());
+    }
+
+    return *this;
+  }
+  // move assignment;
+  // ##usage: vct = std::move(SOME_VECTOR);
+  vector& operator=(vector&& other) noexcept {
+    if (this != &other) {
+      vector cache(::std::move(other));
+      swap(cache);
+    }
+
+    return *this;
+  }
 
   /* end ctor */
 
@@ -236,18 +309,50 @@ class vector {
 
     return;
   }
+  // EM NOTE: the allocators only take back whole blocks,
+  // so the elements are moved to a block of the exact size.
   void shrink_to_fit(void) {
     if (size() == capacity()) {
       return;
     }
 
-    data_allocator::deallocate(data_tail_, mem_tail_ - data_tail_);
-    mem_tail_ = data_tail_;
+    size_type new_capacity = size();
+    iterator new_mem_head = data_allocator::allocate(new_capacity);
+    iterator new_data_tail = new_mem_head;
+    try {
+      new_data_tail = ::lem::uninitialized_copy(mem_head_, data_tail_, new_mem_head);
+    }
+    catch (::std::exception const& e) {
+      // commit or rollback semantics;
+      ::lem::destroy(new_mem_head, new_mem_head + new_capacity);
+      data_allocator::deallocate(new_mem_head, new_capacity);
+      // throw out;
+      throw e;
+    }
+
+    // delete prev vector;
+    ::lem::destroy(begin(), end());
+    data_allocator::deallocate(mem_head_, mem_tail_ - mem_head_);
+
+    // update memory tags;
+    mem_head_ = new_mem_head;
+    data_tail_ = new_data_tail;
+    mem_tail_ = new_mem_head + new_capacity;
 
     return;
   }
   /* end capacity */
 
+ protected:
+  // capacity to reallocate for at least `required` elements;
+  // The capacity is rounded up to what the allocator gives anyway,
+  // i.e. the free-list node size, the malloc() granule or the page.
+  size_type recommend(size_type required) const {
+    return data_allocator::good_size(GrowthPolicy::grow(capacity(), required));
+  }
+
+ public:
+
   /* modifiers */
   iterator insert(iterator pos_iter, value_type const& value, size_type n = 1) {
     if (n == 0) {
@@ -283,10 +388,12 @@ class vector {
       }
     }
     // Now capacity not enough;
+    // EM NOTE: the new capacity follows the growth policy like push_back(),
+    // so repeated insertions reallocate O(log n) times instead of every time.
     else {
-      size_type prev_size = size();
-      size_type new_size = prev_size + max(prev_size, n);
-      iterator new_mem_head = data_allocator::allocate(prev_size + n);
+      size_type new_capacity = recommend(size() + n);
+      iterator new_mem_head = data_allocator::allocate(new_capacity);
+      iterator new_pos = new_mem_head + (pos_iter - mem_head_);
       iterator new_data_tail = new_mem_head;
 
       try {
@@ -296,24 +403,50 @@ class vector {
       }
       catch (::std::exception const& e) {
         // commit or rollback semantics;
-        ::lem::destroy(new_mem_head, new_mem_head + new_size);
-        data_allocator::deallocate(new_mem_head, new_size);
+        ::lem::destroy(new_mem_head, new_mem_head + new_capacity);
+        data_allocator::deallocate(new_mem_head, new_capacity);
         // throw out;
         throw e;
       }
 
       // delete prev vector;
       ::lem::destroy(mem_head_, data_tail_);
-      data_allocator::deallocate(mem_head_, prev_size);
+      data_allocator::deallocate(mem_head_, mem_tail_ - mem_head_);
 
       // update memory tags;
       mem_head_ = new_mem_head;
       data_tail_ = new_data_tail;
-      mem_tail_ = mem_head_ + new_size;
+      mem_tail_ = mem_head_ + new_capacity;
+
+      return new_pos;
     }
 
     return pos_iter;
   }
+  // insert [head, tail) before pos_iter, and return the iterator to the first inserted element;
+  // EM NOTE: the distance of forward iterators is computed up front,
+  // so the vector is reallocated at most once, and trivial types
+  // are copied by a single memmove. [head, tail) should not be a part of the vector.
+  // ##usage: vec.insert(vec.begin(), other.begin(), other.end());
+  template <typename InputIterator, typename = ::lem::__enable_if_iterator<InputIterator>>
+  iterator insert(iterator pos_iter, InputIterator head, InputIterator tail) {
+    return insert_range(pos_iter, head, tail, ::lem::get_iterator_category(head));
+  }
+  // ##usage: vec.append(other.begin(), other.end());
+  template <typename InputIterator, typename = ::lem::__enable_if_iterator<InputIterator>>
+  void append(InputIterator head, InputIterator tail) {
+    insert_range(end(), head, tail, ::lem::get_iterator_category(head));
+
+    return;
+  }
+  // replace the elements by [head, tail), reusing the memory if the capacity is large enough;
+  // ##usage: vec.assign(other.begin(), other.end());
+  template <typename InputIterator, typename = ::lem::__enable_if_iterator<InputIterator>>
+  void assign(InputIterator head, InputIterator tail) {
+    assign_range(head, tail, ::lem::get_iterator_category(head));
+
+    return;
+  }
   void push_back(const value_type& value) {
     if (data_tail_ != mem_tail_) { // memory available;
       ::lem::construct(end(), value);
@@ -329,8 +462,8 @@ class vector {
     // because if construct() fails,
     // the reallocation done by reserve() cannot be rolled back,
     // and iterators will be invalid, which breaks the principle of c/r.
-    size_type prev_size = size();
-    size_type new_size = (prev_size == 0 ? 1 : 2 * prev_size);
+    size_type prev_capacity = capacity();
+    size_type new_size = recommend(prev_capacity + 1);
     iterator new_mem_head = data_allocator::allocate(new_size);
     iterator new_data_tail = new_mem_head;
     try {
@@ -350,7 +483,7 @@ class vector {
 
     // delete prev vector;
     ::lem::destroy(begin(), end());
-    data_allocator::deallocate(mem_head_, prev_size);
+    data_allocator::deallocate(mem_head_, prev_capacity);
 
     // update memory tags;
     mem_head_ = new_mem_head;
@@ -406,7 +539,8 @@ class vector {
     // EM NOTE: here we should not use reserve(),
     // because if uninitialized_fill_n() fails, 
     // the reallocation done by reserve() cannot be rolled back.
-    iterator new_mem_head = data_allocator::allocate(n);
+    size_type new_capacity = recommend(n);
+    iterator new_mem_head = data_allocator::allocate(new_capacity);
     iterator new_data_tail = new_mem_head;
 
     try {
@@ -418,7 +552,7 @@ class vector {
     catch (std::exception const& e) {
       // commit or rollback semantics;
       ::lem::destroy(new_mem_head, new_data_tail);
-      data_allocator::deallocate(new_mem_head, n);
+      data_allocator::deallocate(new_mem_head, new_capacity);
       // throw out;
       throw e;
     }
@@ -430,10 +564,84 @@ class vector {
     // update memory tags;
     mem_head_ = new_mem_head;
     data_tail_ = new_data_tail;
-    mem_tail_ = mem_head_ + n;
+    mem_tail_ = mem_head_ + new_capacity;
+
+    return;
+  }
+  // Resize without value-initializing the new elements of trivial types,
+  // for a buffer about to be overwritten, e.g. by read() or a decoder.
+  // The new elements of the other types are default constructed;
+  // ##usage: vec.resize_default_init(n); in.read(vec.begin(), n);
+  void resize_default_init(size_type n) {
+    if (n <= size()) {
+      resize(n);
+
+      return;
+    }
+
+    // Now n > size();
+    using triv_ctor = typename __type_traits<value_type>::has_trivial_default_ctor;
+    if (n <= capacity()) {
+      data_tail_ = default_init_n(data_tail_, n - size(), triv_ctor());
+
+      return;
+    }
+
+    // Now n > capacity();
+    // EM NOTE: not reserve(), for the same reason as in resize();
+    size_type new_capacity = recommend(n);
+    iterator new_mem_head = data_allocator::allocate(new_capacity);
+    iterator new_data_tail = new_mem_head;
+
+    try {
+      // copy data;
+      new_data_tail = ::lem::uninitialized_copy(mem_head_, data_tail_, new_mem_head);
+      // make the new elements;
+      new_data_tail = default_init_n(new_data_tail, n - size(), triv_ctor());
+    }
+    catch (std::exception const& e) {
+      // commit or rollback semantics;
+      ::lem::destroy(new_mem_head, new_data_tail);
+      data_allocator::deallocate(new_mem_head, new_capacity);
+      // throw out;
+      throw e;
+    }
+
+    // delete prev vector;
+    ::lem::destroy(begin(), end());
+    data_allocator::deallocate(mem_head_, mem_tail_ - mem_head_);
+
+    // update memory tags;
+    mem_head_ = new_mem_head;
+    data_tail_ = new_data_tail;
+    mem_tail_ = mem_head_ + new_capacity;
+
+    return;
+  }
+  void resize_for_overwrite(size_type n) {
+    resize_default_init(n);
 
     return;
   }
+  // Hand the uninitialized memory for n more elements to writer(tail, n),
+  // which returns the number of elements it has constructed there (at most n,
+  // a greater count throws vector_overflow and the size is kept).
+  // Trivial types may be simply assigned, the others should be constructed by construct();
+  // ##usage: vec.reserve_and_append(1024, [&](char* tail, size_t n) { return in.readsome(tail, n); });
+  template <typename Writer>
+  size_type reserve_and_append(size_type n, Writer writer) {
+    if (n > (size_type)(mem_tail_ - data_tail_)) {
+      reserve(recommend(size() + n));
+    }
+
+    size_type written = (size_type)writer(data_tail_, n);
+    if (written > n) {
+      throw lem::vector_overflow("The writer reports more elements than the room it was given. ");
+    }
+    data_tail_ += written;
+
+    return written;
+  }
   // erase() returns the iterator following the last removed element;
   iterator erase(iterator iter) {
     // erasing an empty range is an no-op;
@@ -472,15 +680,194 @@ class vector {
 
     return head;
   }
+  // erase all the elements satisfying pred in a single pass,
+  // and return the number of erased elements;
+  // ##usage: vec.erase_if([](int x) { return x < 0; });
+  template <typename UnaryPredicate>
+  size_type erase_if(UnaryPredicate pred) {
+    iterator new_data_tail = ::lem::remove_if(begin(), end(), pred);
+    size_type count = end() - new_data_tail;
+    erase(new_data_tail, end());
+
+    return count;
+  }
   void clear(void) {
     erase(begin(), end());
   }
+  // exchange the memory of two vectors, O(1);
+  void swap(vector& other) noexcept {
+    ::lem::swap(mem_head_, other.mem_head_);
+    ::lem::swap(data_tail_, other.data_tail_);
+    ::lem::swap(mem_tail_, other.mem_tail_);
+
+    return;
+  }
   /* end modifiers */
+
+ protected:
+  /* range modifiers */
+  // input iterators can only be read once, so the elements are inserted one by one;
+  template <typename InputIterator>
+  iterator insert_range(iterator pos_iter, InputIterator head, InputIterator tail, ::lem::input_iterator_tag) {
+    size_type offset = pos_iter - mem_head_;
+    for (iterator cur = pos_iter; head != tail; ++head) {
+      cur = insert(cur, *head) + 1;
+    }
+
+    return mem_head_ + offset;
+  }
+  template <typename ForwardIterator>
+  iterator insert_range(iterator pos_iter, ForwardIterator head, ForwardIterator tail, ::lem::forward_iterator_tag) {
+    size_type n = (size_type)::lem::distance(head, tail);
+    if (n == 0) {
+      return pos_iter;
+    }
+
+    // if capacity is large enough;
+    if (n <= (size_type)(mem_tail_ - data_tail_)) {
+      size_type num_after_pos = data_tail_ - pos_iter;
+      iterator prev_data_tail = data_tail_;
+      if (num_after_pos > n) {
+        // deal with data in uninitialized memory;
+        ::lem::uninitialized_copy(data_tail_ - n, data_tail_, data_tail_);
+        data_tail_ += n;
+        // move the rest part of existed data;
+        ::lem::copy_backward(pos_iter, prev_data_tail - n, prev_data_tail);
+        // copy new data;
+        ::lem::copy(head, tail, pos_iter);
+      }
+      else {
+        ForwardIterator mid = head;
+        ::lem::advance(mid, num_after_pos);
+        // deal with data in uninitialized memory;
+        ::lem::uninitialized_copy(mid, tail, data_tail_);
+        data_tail_ += n - num_after_pos;
+        // move existed data;
+        ::lem::uninitialized_copy(pos_iter, prev_data_tail, data_tail_);
+        data_tail_ += num_after_pos;
+        // copy the rest part of new data;
+        ::lem::copy(head, mid, pos_iter);
+      }
+
+      return pos_iter;
+    }
+
+    // Now capacity not enough;
+    size_type new_capacity = recommend(size() + n);
+    iterator new_mem_head = data_allocator::allocate(new_capacity);
+    iterator new_pos = new_mem_head + (pos_iter - mem_head_);
+    iterator new_data_tail = new_mem_head;
+
+    try {
+      new_data_tail = ::lem::uninitialized_copy(mem_head_, pos_iter, new_mem_head);
+      new_data_tail = ::lem::uninitialized_copy(head, tail, new_data_tail);
+      new_data_tail = ::lem::uninitialized_copy(pos_iter, data_tail_, new_data_tail);
+    }
+    catch (::std::exception const& e) {
+      // commit or rollback semantics;
+      ::lem::destroy(new_mem_head, new_mem_head + new_capacity);
+      data_allocator::deallocate(new_mem_head, new_capacity);
+      // throw out;
+      throw e;
+    }
+
+    // delete prev vector;
+    ::lem::destroy(mem_head_, data_tail_);
+    data_allocator::deallocate(mem_head_, mem_tail_ - mem_head_);
+
+    // update memory tags;
+    mem_head_ = new_mem_head;
+    data_tail_ = new_data_tail;
+    mem_tail_ = mem_head_ + new_capacity;
+
+    return new_pos;
+  }
+
+  template <typename InputIterator>
+  void assign_range(InputIterator head, InputIterator tail, ::lem::input_iterator_tag) {
+    iterator cur = mem_head_;
+    for (; head != tail && cur != data_tail_; ++head, ++cur) {
+      *cur = *head;
+    }
+    erase(cur, data_tail_);
+    for (; head != tail; ++head) {
+      push_back(*head);
+    }
+
+    return;
+  }
+  template <typename ForwardIterator>
+  void assign_range(ForwardIterator head, ForwardIterator tail, ::lem::forward_iterator_tag) {
+    size_type n = (size_type)::lem::distance(head, tail);
+    if (n > capacity()) {
+      // the memory is allocated once with the exact size;
+      iterator new_mem_head = data_allocator::allocate(n);
+      try {
+        ::lem::uninitialized_copy(head, tail, new_mem_head);
+      }
+      catch (::std::exception const& e) {
+        // commit or rollback semantics;
+        ::lem::destroy(new_mem_head, new_mem_head + n);
+        data_allocator::deallocate(new_mem_head, n);
+        // throw out;
+        throw e;
+      }
+
+      // delete prev vector;
+      ::lem::destroy(mem_head_, data_tail_);
+      data_allocator::deallocate(mem_head_, mem_tail_ - mem_head_);
+
+      // update memory tags;
+      mem_head_ = new_mem_head;
+      data_tail_ = new_mem_head + n;
+      mem_tail_ = data_tail_;
+    }
+    else if (n <= size()) {
+      iterator new_data_tail = ::lem::copy(head, tail, mem_head_);
+      ::lem::destroy(new_data_tail, data_tail_);
+      data_tail_ = new_data_tail;
+    }
+    else {
+      ForwardIterator mid = head;
+      ::lem::advance(mid, size());
+      ::lem::copy(head, mid, mem_head_);
+      data_tail_ = ::lem::uninitialized_copy(mid, tail, data_tail_);
+    }
+
+    return;
+  }
+  // make n elements at the uninitialized head without initialization, and return their end;
+  // the elements made are destroyed if one of them throws;
+  iterator default_init_n(iterator head, size_type n, ::lem::__true_tag) {
+    return head + n;
+  }
+  iterator default_init_n(iterator head, size_type n, ::lem::__false_tag) {
+    iterator cur = head;
+    try {
+      for (; n != 0; --n, ++cur) {
+        ::lem::default_construct(cur);
+      }
+    }
+    catch (::std::exception const& e) {
+      // commit or rollback semantics;
+      ::lem::destroy(head, cur);
+      // throw out;
+      throw e;
+    }
+
+    return cur;
+  }
+  /* end range modifiers */
 };
 
+template <typename DataType, typename AllocType, typename GrowthPolicy>
+inline void swap(vector<DataType, AllocType, GrowthPolicy>& a, vector<DataType, AllocType, GrowthPolicy>& b) noexcept {
+  a.swap(b);
+}
+
 /* vector __type_traits */
-template <typename DataType, typename AllocType>
-struct __type_traits<vector<DataType, AllocType>> {
+template <typename DataType, typename AllocType, typename GrowthPolicy>
+struct __type_traits<vector<DataType, AllocType, GrowthPolicy>> {
   using has_trivial_default_ctor = ::lem::__false_tag;
   using has_trivial_copy_ctor = ::lem::__false_tag;
   using has_trivial_assignment_oprtr = ::lem::__false_tag;
@@ -15,6 +15,16 @@ class pop_empty_vector : public ::std::exception {
 
   explicit pop_empty_vector(const char* _Message) : _Mybase(_Message) {}
 };
+class vector_overflow : public ::std::exception {
+ public:
+  using _Mybase = ::std::exception;
+
+  vector_overflow(void) : _Mybase("Exceeding the fixed capacity of a vector. ") {}
+
+  explicit vector_overflow(const ::std::string& _Message) : _Mybase(_Message.c_str()) {}
+
+  explicit vector_overflow(const char* _Message) : _Mybase(_Message) {}
+};
 class illegal_iterval : public ::std::exception {
  public:
   using _Mybase = ::std::exception;
@@ -0,0 +1,393 @@
+// Conversions between numbers and text without locale;
+#ifndef LEMSTL_LEM_CHARCONV_H_
+#define LEMSTL_LEM_CHARCONV_H_
+
+#include <clocale> // for localeconv();
+#include <cstddef> // for size_t;
+#include <cstdint> // for uint64_t;
+#include <cstdio> // for snprintf();
+#include <cstdlib> // for strtod() and strtof();
+#include <cstring> // for memcpy();
+#include <limits> // for numeric_limits;
+#include <string> // for std::string;
+#include <type_traits> // for std::enable_if and std::is_integral;
+
+namespace lem {
+/* EM NOTE: number parsing */
+// operator>> goes through the locale (num_get facet) and the stream sentry
+// for every single value, which costs far more than the conversion itself.
+// parse_number() only reads [head, tail): no locale, no null terminator,
+// no errno, no allocation on the common path.
+//
+// Integers: an optional sign and decimal digits. A value out of the range
+// of the type is an error, not a wrapped result.
+// Floating point numbers: an optional sign, digits with an optional fraction,
+// and an optional decimal exponent. Values with at most 19 significant digits
+// and a small exponent are computed exactly by a single multiplication or division
+// (Clinger's fast path); the others, as well as inf and nan, fall back to strtod().
+//
+// strtod() and snprintf() follow the decimal point of the C locale (setlocale()),
+// so the fallbacks swap it with '.', and the text is always read and written with '.'.
+inline bool __is_digit(char ch) {
+  return (unsigned char)(ch - '0') < 10;
+}
+
+template <typename IntType>
+char const* __parse_integer(char const* head, char const* tail, IntType& value) {
+  using limits = ::std::numeric_limits<IntType>;
+
+  char const* cur = head;
+  bool negative = false;
+  if (cur != tail && (*cur == '-' || *cur == '+')) {
+    negative = (*cur == '-');
+    if (negative && !limits::is_signed) {
+      return head;
+    }
+    ++cur;
+  }
+
+  ::std::uint64_t bound = ::std::uint64_t(limits::max()) + (negative ? 1 : 0);
+  ::std::uint64_t magnitude = 0;
+  char const* digits = cur;
+  for (; cur != tail && ::lem::__is_digit(*cur); ++cur) {
+    unsigned digit = unsigned(*cur - '0');
+    if (magnitude > (bound - digit) / 10) { // overflow;
+      return head;
+    }
+    magnitude = magnitude * 10 + digit;
+  }
+  if (cur == digits) {
+    return head;
+  }
+
+  value = (negative ? IntType(0 - magnitude) : IntType(magnitude));
+
+  return cur;
+}
+
+// exact powers of 10 in double, 1e22 is the largest one;
+inline double __pow10(int exp) {
+  static constexpr double kPow10[23] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+  };
+
+  return kPow10[exp];
+}
+
+inline void __strto(char const* str, char** end, double& value) {
+  value = ::std::strtod(str, end);
+}
+inline void __strto(char const* str, char** end, float& value) {
+  value = ::std::strtof(str, end);
+}
+inline void __strto(char const* str, char** end, long double& value) {
+  value = ::std::strtold(str, end);
+}
+
+// the decimal point of the C locale;
+inline char const* __locale_point(void) {
+  char const* point = ::std::localeconv()->decimal_point;
+  return (point != nullptr && point[0] != '\0') ? point : ".";
+}
+
+// slow path, the token [head, head + len) is copied to be null terminated,
+// with the decimal point of the locale in place of '.';
+template <typename FloatType>
+char const* __parse_float_fallback(char const* head, size_t len, FloatType& value) {
+  constexpr size_t kLocalSize = 128;
+  char const* point = ::lem::__locale_point();
+  size_t point_len = ::std::strlen(point);
+
+  // the token stops at a second '.', and at text which is a point only in the locale;
+  size_t dot = len;
+  for (size_t ind = 0; ind < len; ++ind) {
+    if (head[ind] == '.') {
+      if (dot != len) {
+        len = ind;
+        break;
+      }
+      dot = ind;
+    }
+    else if (head[ind] == point[0]) {
+      len = ind;
+      break;
+    }
+  }
+
+  size_t size = (dot < len ? len - 1 + point_len : len);
+  char local[kLocalSize];
+  ::std::string remote;
+  char* str = local;
+  if (size >= kLocalSize) {
+    remote.resize(size + 1);
+    str = &remote[0];
+  }
+  if (dot < len) {
+    ::std::memcpy(str, head, dot);
+    ::std::memcpy(str + dot, point, point_len);
+    ::std::memcpy(str + dot + point_len, head + dot + 1, len - dot - 1);
+  }
+  else {
+    ::std::memcpy(str, head, len);
+  }
+  str[size] = '\0';
+
+  char* end = str;
+  FloatType result;
+  ::lem::__strto(str, &end, result);
+  if (end == str) {
+    return head;
+  }
+  value = result;
+
+  // strtod() reads the point as a whole or not at all;
+  size_t used = size_t(end - str);
+  if (dot < len && used > dot) {
+    used -= point_len - 1;
+  }
+
+  return head + used;
+}
+
+// decimal digits of a floating point number, value = mantissa * 10^exp10;
+struct __decimal {
+  ::std::uint64_t mantissa = 0;
+  int exp10 = 0;
+  bool negative = false;
+  bool truncated = false; // nonzero digits beyond the 19 kept in mantissa;
+};
+
+// returns the end of the number, or head if there is no digit;
+inline char const* __scan_decimal(char const* head, char const* tail, __decimal& dec) {
+  constexpr int kMaxDigits = 19; // fit in uint64_t;
+
+  char const* cur = head;
+  if (cur != tail && (*cur == '-' || *cur == '+')) {
+    dec.negative = (*cur == '-');
+    ++cur;
+  }
+
+  int digit_num = 0; // significant digits in mantissa;
+  bool has_digit = false;
+  for (; cur != tail && ::lem::__is_digit(*cur); ++cur) {
+    has_digit = true;
+    if (digit_num < kMaxDigits) {
+      dec.mantissa = dec.mantissa * 10 + unsigned(*cur - '0');
+      digit_num += (dec.mantissa != 0 ? 1 : 0);
+    }
+    else {
+      dec.truncated |= (*cur != '0');
+      ++dec.exp10;
+    }
+  }
+  if (cur != tail && *cur == '.') {
+    ++cur;
+    for (; cur != tail && ::lem::__is_digit(*cur); ++cur) {
+      has_digit = true;
+      if (digit_num < kMaxDigits) {
+        dec.mantissa = dec.mantissa * 10 + unsigned(*cur - '0');
+        digit_num += (dec.mantissa != 0 ? 1 : 0);
+        --dec.exp10;
+      }
+      else {
+        dec.truncated |= (*cur != '0');
+      }
+    }
+  }
+  if (!has_digit) {
+    return head;
+  }
+
+  // the exponent only counts if it has digits, as in strtod();
+  if (cur != tail && (*cur == 'e' || *cur == 'E')) {
+    char const* exp_cur = cur + 1;
+    bool exp_negative = false;
+    if (exp_cur != tail && (*exp_cur == '-' || *exp_cur == '+')) {
+      exp_negative = (*exp_cur == '-');
+      ++exp_cur;
+    }
+    if (exp_cur != tail && ::lem::__is_digit(*exp_cur)) {
+      int exp = 0;
+      for (; exp_cur != tail && ::lem::__is_digit(*exp_cur); ++exp_cur) {
+        if (exp < 100000) { // far beyond any finite value;
+          exp = exp * 10 + (*exp_cur - '0');
+        }
+      }
+      dec.exp10 += (exp_negative ? -exp : exp);
+      cur = exp_cur;
+    }
+  }
+
+  return cur;
+}
+
+// EM NOTE: when both the mantissa and 10^|exp10| are exact in the type,
+// the single rounding of * or / gives the correctly rounded result.
+// Exact ranges: double keeps 53 bits and 10^22, float keeps 24 bits and 10^10;
+inline bool __fast_decimal(__decimal const& dec, double& value) {
+  if (dec.truncated || dec.mantissa > (::std::uint64_t(1) << 53) || dec.exp10 < -22 || dec.exp10 > 22) {
+    return false;
+  }
+
+  double result = double(dec.mantissa);
+  result = (dec.exp10 < 0 ? result / ::lem::__pow10(-dec.exp10) : result * ::lem::__pow10(dec.exp10));
+  value = (dec.negative ? -result : result);
+
+  return true;
+}
+inline bool __fast_decimal(__decimal const& dec, float& value) {
+  if (dec.truncated || dec.mantissa > (::std::uint64_t(1) << 24) || dec.exp10 < -10 || dec.exp10 > 10) {
+    return false;
+  }
+
+  float result = float(dec.mantissa);
+  float scale = float(::lem::__pow10(dec.exp10 < 0 ? -dec.exp10 : dec.exp10));
+  result = (dec.exp10 < 0 ? result / scale : result * scale);
+  value = (dec.negative ? -result : result);
+
+  return true;
+}
+inline bool __fast_decimal(__decimal const&, long double&) {
+  return false;
+}
+
+template <typename FloatType>
+char const* __parse_float(char const* head, char const* tail, FloatType& value) {
+  __decimal dec;
+  char const* end = ::lem::__scan_decimal(head, tail, dec);
+  if (end == head) { // inf, nan, or not a number;
+    size_t len = size_t(tail - head);
+    return ::lem::__parse_float_fallback(head, (len < 16 ? len : 16), value);
+  }
+
+  if (::lem::__fast_decimal(dec, value)) {
+    return end;
+  }
+
+  return ::lem::__parse_float_fallback(head, size_t(end - head), value);
+}
+
+/* parse_number() */
+// Parse the number at head and return its end, or head if there is no valid number.
+// value is only changed on success.
+// ##usage: char const* end = lem::parse_number(text, text + len, value);
+template <typename T>
+inline char const* parse_number(char const* head, char const* tail, T& value) {
+  return ::lem::__parse_integer(head, tail, value);
+}
+inline char const* parse_number(char const* head, char const* tail, float& value) {
+  return ::lem::__parse_float(head, tail, value);
+}
+inline char const* parse_number(char const* head, char const* tail, double& value) {
+  return ::lem::__parse_float(head, tail, value);
+}
+inline char const* parse_number(char const* head, char const* tail, long double& value) {
+  return ::lem::__parse_float(head, tail, value);
+}
+/* end parse_number() */
+/* end number parsing */
+
+/* format_number() */
+// Write value to [head, tail) and return the end of the text,
+// or head if there is not enough room.
+// Floating point numbers are written with enough digits to be read back exactly.
+constexpr size_t __kMaxNumberChars = 48;
+
+template <typename IntType>
+char* __format_integer(char* head, char* tail, IntType value) {
+  static constexpr char kDigitPairs[] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+  char local[24];
+  char* cur = local + sizeof(local);
+  bool negative = (value < 0);
+  ::std::uint64_t magnitude = (negative ? 0 - ::std::uint64_t(value) : ::std::uint64_t(value));
+
+  // two digits per division;
+  while (magnitude >= 100) {
+    unsigned pair = unsigned(magnitude % 100) * 2;
+    magnitude /= 100;
+    *--cur = kDigitPairs[pair + 1];
+    *--cur = kDigitPairs[pair];
+  }
+  if (magnitude >= 10) {
+    unsigned pair = unsigned(magnitude) * 2;
+    *--cur = kDigitPairs[pair + 1];
+    *--cur = kDigitPairs[pair];
+  }
+  else {
+    *--cur = char('0' + magnitude);
+  }
+  if (negative) {
+    *--cur = '-';
+  }
+
+  size_t len = size_t(local + sizeof(local) - cur);
+  if (len > size_t(tail - head)) {
+    return head;
+  }
+  ::std::memcpy(head, cur, len);
+
+  return head + len;
+}
+
+inline int __print_float(char* buf, size_t size, float value) {
+  return ::std::snprintf(buf, size, "%.*g", ::std::numeric_limits<float>::max_digits10, double(value));
+}
+inline int __print_float(char* buf, size_t size, double value) {
+  return ::std::snprintf(buf, size, "%.*g", ::std::numeric_limits<double>::max_digits10, value);
+}
+inline int __print_float(char* buf, size_t size, long double value) {
+  return ::std::snprintf(buf, size, "%.*Lg", ::std::numeric_limits<long double>::max_digits10, value);
+}
+
+template <typename FloatType>
+char* __format_float(char* head, char* tail, FloatType value) {
+  char local[__kMaxNumberChars];
+  int len = ::lem::__print_float(local, sizeof(local), value);
+  if (len < 0 || size_t(len) >= sizeof(local)) {
+    return head;
+  }
+
+  // the decimal point of the locale is written back as '.';
+  char const* point = ::lem::__locale_point();
+  if (point[0] != '.' || point[1] != '\0') {
+    char* found = ::std::strstr(local, point);
+    if (found != nullptr) {
+      size_t point_len = ::std::strlen(point);
+      *found = '.';
+      ::std::memmove(found + 1, found + point_len, size_t(local + len - found) - point_len + 1);
+      len -= int(point_len - 1);
+    }
+  }
+
+  if (size_t(len) > size_t(tail - head)) {
+    return head;
+  }
+  ::std::memcpy(head, local, size_t(len));
+
+  return head + len;
+}
+
+// integral types only, other types would be truncated silently;
+template <typename T>
+inline typename ::std::enable_if<::std::is_integral<T>::value, char*>::type
+format_number(char* head, char* tail, T value) {
+  return ::lem::__format_integer(head, tail, value);
+}
+inline char* format_number(char* head, char* tail, float value) {
+  return ::lem::__format_float(head, tail, value);
+}
+inline char* format_number(char* head, char* tail, double value) {
+  return ::lem::__format_float(head, tail, value);
+}
+inline char* format_number(char* head, char* tail, long double value) {
+  return ::lem::__format_float(head, tail, value);
+}
+/* end format_number() */
+} /* end lem */
+
+#endif /* LEMSTL_LEM_CHARCONV_H_ */
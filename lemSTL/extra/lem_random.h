@@ -0,0 +1,266 @@
+// Pseudo-random number generation, shuffle() and sample();
+#ifndef LEMSTL_LEM_RANDOM_H_
+#define LEMSTL_LEM_RANDOM_H_
+
+#include <cstddef> // for size_t;
+#include <cstdint> // for uint64_t;
+#if defined(_MSC_VER) && defined(_M_X64)
+  #include <intrin.h> // for _umul128();
+#endif
+
+#include "../lem_iterator" // for iterator_traits and distance();
+#include "../algorithm/lem_algobase.h" // for swap();
+
+namespace lem {
+/* splitmix64 */
+// Expand a single 64-bit seed into the state of larger generators.
+// Consecutive seeds give unrelated outputs.
+inline ::std::uint64_t __splitmix64(::std::uint64_t& state) {
+  ::std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+
+  return z ^ (z >> 31);
+}
+/* end splitmix64 */
+
+/* xoshiro256pp */
+// See https://prng.di.unimi.it/ by D. Blackman and S. Vigna;
+// EM NOTE: xoshiro256++ keeps 32 bytes of state and costs a few shifts,
+// rotations and xors per 64-bit output, while mt19937 keeps 2.5 KB of state
+// and only gives 32 bits per call.
+// It satisfies the UniformRandomBitGenerator requirements,
+// so it also works with the <random> distributions.
+// ##usage: lem::xoshiro256pp gen(42); auto x = gen();
+class xoshiro256pp {
+ public:
+  using result_type = ::std::uint64_t;
+
+ private:
+  result_type state_[4];
+
+  static result_type rotl(result_type x, int k) {
+    return (x << k) | (x >> (64 - k));
+  }
+
+ public:
+  /* ctor */
+  explicit xoshiro256pp(result_type seed = 0) {
+    this->seed(seed);
+  }
+  /* end ctor */
+
+  // the state must not be all zeros, which splitmix64 never produces;
+  void seed(result_type seed) {
+    for (size_t ind = 0; ind < 4; ++ind) {
+      state_[ind] = ::lem::__splitmix64(seed);
+    }
+
+    return;
+  }
+
+  static constexpr result_type min(void) {
+    return 0;
+  }
+  static constexpr result_type max(void) {
+    return ~result_type(0);
+  }
+
+  result_type operator()(void) {
+    result_type result = rotl(state_[0] + state_[3], 23) + state_[0];
+    result_type t = state_[1] << 17;
+
+    state_[2] ^= state_[0];
+    state_[3] ^= state_[1];
+    state_[1] ^= state_[2];
+    state_[0] ^= state_[3];
+    state_[2] ^= t;
+    state_[3] = rotl(state_[3], 45);
+
+    return result;
+  }
+
+  // Advance the state by 2^128 calls.
+  // Generators copied and jumped k times give k non-overlapping streams,
+  // e.g. one per thread of a load generator.
+  void jump(void) {
+    static constexpr result_type kJump[4] = {
+      0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull,
+      0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull
+    };
+
+    result_type jumped[4] = { 0, 0, 0, 0 };
+    for (size_t word = 0; word < 4; ++word) {
+      for (int bit = 0; bit < 64; ++bit) {
+        if (kJump[word] & (result_type(1) << bit)) {
+          for (size_t ind = 0; ind < 4; ++ind) {
+            jumped[ind] ^= state_[ind];
+          }
+        }
+        (*this)();
+      }
+    }
+    for (size_t ind = 0; ind < 4; ++ind) {
+      state_[ind] = jumped[ind];
+    }
+
+    return;
+  }
+
+  friend bool operator==(xoshiro256pp const& lhs, xoshiro256pp const& rhs) {
+    for (size_t ind = 0; ind < 4; ++ind) {
+      if (lhs.state_[ind] != rhs.state_[ind]) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+  friend bool operator!=(xoshiro256pp const& lhs, xoshiro256pp const& rhs) {
+    return !(lhs == rhs);
+  }
+};
+/* end xoshiro256pp */
+
+/* bounded integers */
+// high and low halves of the 128-bit product a * b;
+inline ::std::uint64_t __mul_128(::std::uint64_t a, ::std::uint64_t b, ::std::uint64_t& low) {
+#if defined(_MSC_VER) && defined(_M_X64)
+  ::std::uint64_t high = 0;
+  low = _umul128(a, b, &high);
+
+  return high;
+#elif defined(__SIZEOF_INT128__)
+  unsigned __int128 product = (unsigned __int128)a * b;
+  low = (::std::uint64_t)product;
+
+  return (::std::uint64_t)(product >> 64);
+#else
+  ::std::uint64_t a_lo = a & 0xFFFFFFFFull;
+  ::std::uint64_t a_hi = a >> 32;
+  ::std::uint64_t b_lo = b & 0xFFFFFFFFull;
+  ::std::uint64_t b_hi = b >> 32;
+  ::std::uint64_t lo_lo = a_lo * b_lo;
+  ::std::uint64_t hi_lo = a_hi * b_lo;
+  ::std::uint64_t lo_hi = a_lo * b_hi;
+  ::std::uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFFull) + lo_hi;
+  low = (cross << 32) | (lo_lo & 0xFFFFFFFFull);
+
+  return a_hi * b_hi + (hi_lo >> 32) + (cross >> 32);
+#endif
+}
+
+// Uniform integer in [0, bound), bound > 0.
+// EM NOTE: Lemire's method (https://arxiv.org/abs/1805.10941).
+// The high half of x * bound is uniform in [0, bound) except for a few values of x,
+// which are detected from the low half and rejected.
+// Unlike x % bound, there is no modulo bias, and the only division
+// is computed on the rare path, with probability bound / 2^64.
+// URBG must give uniform 64-bit outputs, e.g. xoshiro256pp or std::mt19937_64.
+template <typename URBG>
+::std::uint64_t bounded_rand(URBG& gen, ::std::uint64_t bound) {
+  static_assert(URBG::min() == 0 && URBG::max() == ~::std::uint64_t(0),
+                "bounded_rand() requires a generator of 64-bit outputs. ");
+
+  ::std::uint64_t low = 0;
+  ::std::uint64_t high = ::lem::__mul_128(gen(), bound, low);
+
+  if (low < bound) {
+    ::std::uint64_t threshold = (0 - bound) % bound; // 2^64 % bound;
+    while (low < threshold) {
+      high = ::lem::__mul_128(gen(), bound, low);
+    }
+  }
+
+  return high;
+}
+
+// Uniform integer in [lo, hi];
+// ##usage: int dice = lem::uniform_int(gen, 1, 6);
+template <typename IntType, typename URBG>
+inline IntType uniform_int(URBG& gen, IntType lo, IntType hi) {
+  ::std::uint64_t range = ::std::uint64_t(hi) - ::std::uint64_t(lo);
+  if (range == ~::std::uint64_t(0)) { // the whole 64-bit range;
+    return IntType(gen());
+  }
+
+  return IntType(::std::uint64_t(lo) + ::lem::bounded_rand(gen, range + 1));
+}
+
+// Uniform floating point number in [lo, hi),
+// from the 53 high bits of one output;
+template <typename URBG>
+inline double uniform_real(URBG& gen, double lo = 0.0, double hi = 1.0) {
+  double canonical = double(::std::uint64_t(gen()) >> 11) * (1.0 / 9007199254740992.0); // 2^-53;
+
+  return lo + (hi - lo) * canonical;
+}
+/* end bounded integers */
+
+/* shuffle() */
+// Fisher-Yates shuffle, every permutation is equally likely;
+template <typename RandomAccessIterator, typename URBG>
+void shuffle(RandomAccessIterator head, RandomAccessIterator tail, URBG& gen) {
+  using diff_type = typename iterator_traits<RandomAccessIterator>::difference_type;
+
+  diff_type len = tail - head;
+  for (diff_type ind = len - 1; ind > 0; --ind) {
+    diff_type pick = (diff_type)::lem::bounded_rand(gen, ::std::uint64_t(ind) + 1);
+    if (pick != ind) {
+      ::lem::swap(*(head + ind), *(head + pick));
+    }
+  }
+
+  return;
+}
+/* end shuffle() */
+
+/* sample() */
+// Copy n elements chosen uniformly without replacement from [head, tail) to result,
+// and return the end of the output.
+// EM NOTE: forward input uses selection sampling (Knuth's algorithm S),
+// which reads the input once and keeps the relative order of the chosen elements.
+// Single-pass input uses reservoir sampling, which writes result randomly,
+// so result must be random access then, and the order is not kept.
+template <typename ForwardIterator, typename OutputIterator, typename URBG>
+OutputIterator __sample(ForwardIterator head, ForwardIterator tail, OutputIterator result,
+                        size_t n, URBG& gen, ::lem::forward_iterator_tag) {
+  ::std::uint64_t remain = (::std::uint64_t)::lem::distance(head, tail);
+  ::std::uint64_t needed = (n < remain ? n : remain);
+
+  for (; needed != 0; ++head, --remain) {
+    // choose *head with probability needed / remain;
+    if (::lem::bounded_rand(gen, remain) < needed) {
+      *result = *head;
+      ++result;
+      --needed;
+    }
+  }
+
+  return result;
+}
+template <typename InputIterator, typename RandomAccessIterator, typename URBG>
+RandomAccessIterator __sample(InputIterator head, InputIterator tail, RandomAccessIterator result,
+                              size_t n, URBG& gen, ::lem::input_iterator_tag) {
+  size_t filled = 0;
+  for (; head != tail && filled < n; ++head, ++filled) {
+    *(result + filled) = *head;
+  }
+  // the (seen + 1)-th element replaces a random one with probability n / (seen + 1);
+  for (::std::uint64_t seen = filled; head != tail; ++head, ++seen) {
+    ::std::uint64_t pick = ::lem::bounded_rand(gen, seen + 1);
+    if (pick < n) {
+      *(result + pick) = *head;
+    }
+  }
+
+  return result + filled;
+}
+template <typename InputIterator, typename OutputIterator, typename URBG>
+inline OutputIterator sample(InputIterator head, InputIterator tail, OutputIterator result, size_t n, URBG& gen) {
+  return ::lem::__sample(head, tail, result, n, gen, ::lem::get_iterator_category(head));
+}
+/* end sample() */
+} /* end lem */
+
+#endif /* LEMSTL_LEM_RANDOM_H_ */
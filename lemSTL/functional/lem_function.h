@@ -0,0 +1,52 @@
+// Function objects for comparison and arithmetic;
+#ifndef LEMSTL_LEM_FUNCTION_H_
+#define LEMSTL_LEM_FUNCTION_H_
+
+namespace lem {
+/* comparisons */
+// EM NOTE: algorithms without a user-given comparator
+// fall back to these functors, so that each algorithm
+// only needs one implementation taking a comparator.
+template <typename T>
+struct less {
+  bool operator()(T const& a, T const& b) const {
+    return a < b;
+  }
+};
+template <typename T>
+struct greater {
+  bool operator()(T const& a, T const& b) const {
+    return b < a;
+  }
+};
+template <typename T>
+struct equal_to {
+  bool operator()(T const& a, T const& b) const {
+    return a == b;
+  }
+};
+/* end comparisons */
+
+/* arithmetic operations */
+template <typename T>
+struct plus {
+  T operator()(T const& a, T const& b) const {
+    return a + b;
+  }
+};
+template <typename T>
+struct minus {
+  T operator()(T const& a, T const& b) const {
+    return a - b;
+  }
+};
+template <typename T>
+struct multiplies {
+  T operator()(T const& a, T const& b) const {
+    return a * b;
+  }
+};
+/* end arithmetic operations */
+} /* end lem */
+
+#endif /* LEMSTL_LEM_FUNCTION_H_ */
@@ -4,6 +4,8 @@
 
 #include <cstddef> // for ::std::ptrdiff_t;
 
+#include "../lem_type_traits" // for condition tags;
+
 namespace lem {
 // Iterator category tags;
 struct input_iterator_tag {};
@@ -11,6 +13,9 @@ struct output_iterator_tag {};
 struct forward_iterator_tag : input_iterator_tag {};
 struct bidirectional_iterator_tag : forward_iterator_tag {};
 struct random_access_iterator_tag : bidirectional_iterator_tag {};
+// Elements of a contiguous iterator are adjacent in memory, i.e. *(iter + n) is
+// *(to_address(iter) + n), so algorithms may work on the native pointers instead;
+struct contiguous_iterator_tag : random_access_iterator_tag {};
 
 // lem::iterator type;
 // Every container should specify its own iterator;
@@ -42,7 +47,7 @@ struct iterator_traits {
 // partial specialization for native pointers;
 template <typename T>
 struct iterator_traits<T*> {
-  using iterator_category = random_access_iterator_tag;
+  using iterator_category = contiguous_iterator_tag;
   using value_type = T;
   using difference_type = std::ptrdiff_t;
   using pointer_type = T*;
@@ -51,7 +56,7 @@ struct iterator_traits<T*> {
 // partial specialization for native const pointers;
 template <typename T>
 struct iterator_traits<T const*> {
-  using iterator_category = random_access_iterator_tag;
+  using iterator_category = contiguous_iterator_tag;
   using value_type = T;
   using difference_type = std::ptrdiff_t;
   using pointer_type = T const*;
@@ -78,6 +83,98 @@ get_iterator_category(Iter const&) {
 }
 /* end functions to fetch nullptr */
 
+/* to_address() */
+// Native pointer to the element of a contiguous iterator (or any fancy pointer).
+// Iterators are unwrapped through operator->(), so a wrapper around a pointer
+// only has to declare contiguous_iterator_tag to get the native pointer paths;
+template <typename T>
+constexpr T* to_address(T* ptr) noexcept {
+  return ptr;
+}
+template <typename Iter>
+inline auto to_address(Iter const& iter) noexcept -> decltype(::lem::to_address(iter.operator->())) {
+  return ::lem::to_address(iter.operator->());
+}
+
+// __iterator_contiguity<Iter>::type is __true_tag for contiguous iterators.
+// Types without iterator_category (e.g. plain output functors) are not contiguous;
+template <typename... Ts>
+struct __make_void {
+  using type = void;
+};
+inline __true_tag __contiguity(::lem::contiguous_iterator_tag) {
+  return __true_tag();
+}
+inline __false_tag __contiguity(::lem::input_iterator_tag) {
+  return __false_tag();
+}
+inline __false_tag __contiguity(::lem::output_iterator_tag) {
+  return __false_tag();
+}
+template <typename Iter, typename = void>
+struct __iterator_contiguity {
+  using type = __false_tag;
+};
+template <typename Iter>
+struct __iterator_contiguity<Iter, typename __make_void<typename Iter::iterator_category>::type> {
+  using type = decltype(::lem::__contiguity(typename Iter::iterator_category()));
+};
+template <typename T>
+struct __iterator_contiguity<T*, void> {
+  using type = __true_tag;
+};
+/* end to_address() */
+
+// __enable_if_iterator<Iter> is void for iterators and ill-formed for other types,
+// so that e.g. insert(pos, 3, 5) is not taken for an iterator range;
+template <typename Iter, typename = void>
+struct __iterator_check {};
+template <typename Iter>
+struct __iterator_check<Iter, typename __make_void<typename Iter::iterator_category>::type> {
+  using type = void;
+};
+template <typename T>
+struct __iterator_check<T*, void> {
+  using type = void;
+};
+template <typename Iter>
+using __enable_if_iterator = typename __iterator_check<Iter>::type;
+
+/* segmented iterators */
+// EM NOTE: a segmented iterator walks a sequence of contiguous segments,
+// e.g. the chunks of stable_vector. Algorithms take it apart into
+// one native pointer range per segment, so the inner loops have no
+// segment check per element, and take the native pointer paths (memset, SIMD).
+//
+// A segmented iterator type specializes __segmented_iterator_traits with
+//   is_segmented                  __true_tag;
+//   local_iterator                the native pointer type;
+//   local(iter)                   position of iter in its segment;
+//   segment_end(iter)             end of the segment of iter;
+//   next_segment(iter)            move iter to the head of the next segment;
+//   same_segment(iter1, iter2)    whether the two are in the same segment;
+template <typename Iter>
+struct __segmented_iterator_traits {
+  using is_segmented = __false_tag;
+};
+template <typename Iter>
+using __is_segmented_iterator = typename __segmented_iterator_traits<Iter>::is_segmented;
+
+// Call f(local_head, local_tail) for each segment piece of [head, tail);
+template <typename SegmentedIterator, typename Function>
+inline void __for_each_segment(SegmentedIterator head, SegmentedIterator tail, Function& f) {
+  using traits = __segmented_iterator_traits<SegmentedIterator>;
+
+  while (!traits::same_segment(head, tail)) {
+    f(traits::local(head), traits::segment_end(head));
+    traits::next_segment(head);
+  }
+  f(traits::local(head), traits::local(tail));
+
+  return;
+}
+/* end segmented iterators */
+
 /* distance */
 template <typename InputIterator>
 inline typename iterator_traits<InputIterator>::difference_type
@@ -131,6 +228,46 @@ inline void advance(InputIterator& iter, Distance dist = 1) {
   __advance(iter, dist, ::lem::get_iterator_category(iter));
 }
 /* end advance */
+
+/* back_insert_iterator */
+// Output iterator which push_back()s every value assigned to it;
+// ##usage: lem::copy(head, tail, lem::back_inserter(vec));
+template <typename Container>
+class back_insert_iterator {
+ public:
+  using iterator_category = output_iterator_tag;
+  using value_type = void;
+  using difference_type = void;
+  using pointer_type = void;
+  using reference_type = void;
+
+ protected:
+  Container* container_;
+
+ public:
+  explicit back_insert_iterator(Container& container) : container_(&container) {}
+
+  back_insert_iterator& operator=(typename Container::value_type const& value) {
+    container_->push_back(value);
+    return *this;
+  }
+
+  // dereference and increment are no-ops;
+  back_insert_iterator& operator*(void) {
+    return *this;
+  }
+  back_insert_iterator& operator++(void) {
+    return *this;
+  }
+  back_insert_iterator& operator++(int) {
+    return *this;
+  }
+};
+template <typename Container>
+inline back_insert_iterator<Container> back_inserter(Container& container) {
+  return back_insert_iterator<Container>(container);
+}
+/* end back_insert_iterator */
 } /* end lem */
 
 #endif
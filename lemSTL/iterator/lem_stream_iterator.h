@@ -0,0 +1,381 @@
+// Buffered stream readers, writers and their iterators;
+#ifndef LEMSTL_LEM_STREAM_ITERATOR_H_
+#define LEMSTL_LEM_STREAM_ITERATOR_H_
+
+#include <cstddef> // for size_t and ptrdiff_t;
+#include <cstring> // for memmove(), memcpy() and strlen();
+#include <istream> // for std::istream;
+#include <ostream> // for std::ostream;
+#include <streambuf> // for std::streambuf;
+
+#include "lem_iterator.h" // for iterator tags;
+#include "../allocator/lem_alloc.h" // for simple_alloc;
+#include "../extra/lem_charconv.h" // for parse_number() and format_number();
+
+namespace lem {
+/* EM NOTE: buffered streams */
+// std::istream_iterator reads every value by operator>>, i.e. a sentry,
+// a locale lookup and a few virtual calls per value.
+// buffered_reader pulls large blocks from the streambuf with sgetn()
+// and parses them in place by parse_number(), and buffered_writer
+// formats into its own block and hands it over by sputn() when full.
+// The iterators only keep a pointer to the reader or writer,
+// so they stay cheap to copy as iterators should be.
+//
+// Neither one synchronizes with other users of the same streambuf:
+// do not mix them with operator>> or operator<< on the same stream.
+constexpr size_t __kStreamBufferSize = size_t(1) << 16; // 64 KB;
+
+inline bool __is_space(char ch) {
+  return ch == ' ' || (ch >= '\t' && ch <= '\r'); // \t \n \v \f \r;
+}
+
+/* buffered_reader */
+// ##usage: lem::buffered_reader reader(std::cin);
+class buffered_reader {
+ private:
+  using buffer_allocator = ::lem::simple_alloc<char, ::lem::alloc>;
+
+  ::std::streambuf* source_;
+  char* buffer_;
+  size_t capacity_;
+  char* head_; // next unread char;
+  char* tail_; // end of the data read;
+  bool eof_;
+  bool fail_;
+
+ public:
+  /* ctor */
+  explicit buffered_reader(::std::streambuf* source, size_t capacity = __kStreamBufferSize)
+      : source_(source),
+        buffer_(buffer_allocator::allocate(capacity)),
+        capacity_(capacity),
+        head_(buffer_),
+        tail_(buffer_),
+        eof_(false),
+        fail_(false) {}
+  explicit buffered_reader(::std::istream& in, size_t capacity = __kStreamBufferSize)
+      : buffered_reader(in.rdbuf(), capacity) {}
+
+  buffered_reader(buffered_reader const&) = delete;
+  buffered_reader& operator=(buffered_reader const&) = delete;
+  /* end ctor */
+
+  /* dtor */
+  ~buffered_reader(void) {
+    buffer_allocator::deallocate(buffer_, capacity_);
+  }
+  /* end dtor */
+
+  // the input is exhausted;
+  bool eof(void) const noexcept {
+    return eof_ && head_ == tail_;
+  }
+  // the last read() met a malformed token, or a token longer than the buffer;
+  bool fail(void) const noexcept {
+    return fail_;
+  }
+
+  // Read the next whitespace separated number into value.
+  // Return false at the end of the input or on a malformed token,
+  // and every later read() fails as well;
+  template <typename T>
+  bool read(T& value) {
+    if (fail_) {
+      return false;
+    }
+
+    // skip whitespaces;
+    for (;;) {
+      while (head_ != tail_ && ::lem::__is_space(*head_)) {
+        ++head_;
+      }
+      if (head_ != tail_) {
+        break;
+      }
+      if (refill() == 0) {
+        return false;
+      }
+    }
+
+    // the whole token must be in the buffer before parsing;
+    char* end = head_;
+    for (;;) {
+      while (end != tail_ && !::lem::__is_space(*end)) {
+        ++end;
+      }
+      if (end != tail_ || eof_) {
+        break;
+      }
+
+      ptrdiff_t scanned = end - head_;
+      if (refill() == 0 && !eof_) { // the token fills the whole buffer;
+        fail_ = true;
+
+        return false;
+      }
+      end = head_ + scanned;
+    }
+
+    if (::lem::parse_number(head_, end, value) != end) {
+      fail_ = true;
+
+      return false;
+    }
+    head_ = end;
+
+    return true;
+  }
+
+ private:
+  // Move the unread data to the front of the buffer and fill the rest,
+  // return the number of chars read;
+  size_t refill(void) {
+    size_t remain = size_t(tail_ - head_);
+    if (head_ != buffer_) {
+      ::std::memmove(buffer_, head_, remain);
+      head_ = buffer_;
+      tail_ = buffer_ + remain;
+    }
+    if (remain == capacity_) {
+      return 0;
+    }
+
+    ::std::streamsize count = source_->sgetn(tail_, ::std::streamsize(capacity_ - remain));
+    if (count <= 0) {
+      eof_ = true;
+
+      return 0;
+    }
+    tail_ += count;
+
+    return size_t(count);
+  }
+};
+/* end buffered_reader */
+
+/* buffered_writer */
+// The buffer is flushed when full, by flush(), and by the dtor;
+// ##usage: lem::buffered_writer writer(std::cout);
+class buffered_writer {
+ private:
+  using buffer_allocator = ::lem::simple_alloc<char, ::lem::alloc>;
+
+  ::std::streambuf* sink_;
+  char* buffer_;
+  size_t capacity_;
+  char* cur_;
+
+ public:
+  /* ctor */
+  explicit buffered_writer(::std::streambuf* sink, size_t capacity = __kStreamBufferSize)
+      : sink_(sink),
+        buffer_(buffer_allocator::allocate(capacity < __kMaxNumberChars ? __kMaxNumberChars : capacity)),
+        capacity_(capacity < __kMaxNumberChars ? __kMaxNumberChars : capacity),
+        cur_(buffer_) {}
+  explicit buffered_writer(::std::ostream& out, size_t capacity = __kStreamBufferSize)
+      : buffered_writer(out.rdbuf(), capacity) {}
+
+  buffered_writer(buffered_writer const&) = delete;
+  buffered_writer& operator=(buffered_writer const&) = delete;
+  /* end ctor */
+
+  /* dtor */
+  ~buffered_writer(void) {
+    flush();
+    buffer_allocator::deallocate(buffer_, capacity_);
+  }
+  /* end dtor */
+
+  void put(char ch) {
+    if (cur_ == buffer_ + capacity_) {
+      flush();
+    }
+    *cur_++ = ch;
+
+    return;
+  }
+  void write(char const* data, size_t len) {
+    if (len > size_t(buffer_ + capacity_ - cur_)) {
+      flush();
+      if (len >= capacity_) { // too large to be buffered;
+        sink_->sputn(data, ::std::streamsize(len));
+
+        return;
+      }
+    }
+    ::std::memcpy(cur_, data, len);
+    cur_ += len;
+
+    return;
+  }
+  template <typename T>
+  void write_number(T value) {
+    if (size_t(buffer_ + capacity_ - cur_) < __kMaxNumberChars) {
+      flush();
+    }
+    cur_ = ::lem::format_number(cur_, buffer_ + capacity_, value);
+
+    return;
+  }
+
+  void flush(void) {
+    if (cur_ != buffer_) {
+      sink_->sputn(buffer_, ::std::streamsize(cur_ - buffer_));
+      cur_ = buffer_;
+    }
+
+    return;
+  }
+};
+/* end buffered_writer */
+
+/* istream_iterator */
+// Input iterator over the numbers of a buffered_reader.
+// The default constructed iterator is the end-of-stream iterator,
+// which every iterator becomes at the end of the input or on a malformed token;
+// ##usage: lem::copy(lem::istream_iterator<int>(reader), lem::istream_iterator<int>(), lem::back_inserter(vec));
+template <typename T>
+class istream_iterator {
+ public:
+  using iterator_category = input_iterator_tag;
+  using value_type = T;
+  using difference_type = ptrdiff_t;
+  using pointer_type = T const*;
+  using reference_type = T const&;
+
+ private:
+  buffered_reader* reader_;
+  T value_;
+
+ public:
+  /* ctor */
+  istream_iterator(void) : reader_(nullptr), value_() {}
+  explicit istream_iterator(buffered_reader& reader) : reader_(&reader), value_() {
+    read();
+  }
+  /* end ctor */
+
+  // equality;
+  // Two iterators are equal if both are end-of-stream iterators or they share the reader;
+  bool operator==(istream_iterator const& iter) const {
+    return reader_ == iter.reader_;
+  }
+  bool operator!=(istream_iterator const& iter) const {
+    return reader_ != iter.reader_;
+  }
+
+  // dereference;
+  reference_type operator*(void) const {
+    return value_;
+  }
+  pointer_type operator->(void) const {
+    return &value_;
+  }
+
+  // prefix incre;
+  istream_iterator& operator++(void) {
+    read();
+    return *this;
+  }
+  // postfix incre;
+  istream_iterator operator++(int) {
+    istream_iterator cache = *this;
+    read();
+    return cache;
+  }
+
+ private:
+  void read(void) {
+    if (!reader_->read(value_)) {
+      reader_ = nullptr;
+    }
+
+    return;
+  }
+};
+/* end istream_iterator */
+
+/* ostreambuf_iterator */
+// Output iterator writing chars to a buffered_writer;
+template <typename CharType = char>
+class ostreambuf_iterator {
+ public:
+  using iterator_category = output_iterator_tag;
+  using value_type = void;
+  using difference_type = void;
+  using pointer_type = void;
+  using reference_type = void;
+
+ private:
+  buffered_writer* writer_;
+
+ public:
+  explicit ostreambuf_iterator(buffered_writer& writer) : writer_(&writer) {}
+
+  ostreambuf_iterator& operator=(CharType ch) {
+    writer_->put(char(ch));
+    return *this;
+  }
+
+  // dereference and increment are no-ops;
+  ostreambuf_iterator& operator*(void) {
+    return *this;
+  }
+  ostreambuf_iterator& operator++(void) {
+    return *this;
+  }
+  ostreambuf_iterator& operator++(int) {
+    return *this;
+  }
+};
+/* end ostreambuf_iterator */
+
+/* ostream_iterator */
+// Output iterator writing numbers to a buffered_writer,
+// each followed by the delimiter if there is one;
+// ##usage: lem::copy(vec.begin(), vec.end(), lem::ostream_iterator<int>(writer, "\n"));
+template <typename T>
+class ostream_iterator {
+ public:
+  using iterator_category = output_iterator_tag;
+  using value_type = void;
+  using difference_type = void;
+  using pointer_type = void;
+  using reference_type = void;
+
+ private:
+  buffered_writer* writer_;
+  char const* delimiter_;
+  size_t delimiter_len_;
+
+ public:
+  explicit ostream_iterator(buffered_writer& writer, char const* delimiter = nullptr)
+      : writer_(&writer),
+        delimiter_(delimiter),
+        delimiter_len_(delimiter == nullptr ? 0 : ::std::strlen(delimiter)) {}
+
+  ostream_iterator& operator=(T const& value) {
+    writer_->write_number(value);
+    if (delimiter_len_ != 0) {
+      writer_->write(delimiter_, delimiter_len_);
+    }
+    return *this;
+  }
+
+  // dereference and increment are no-ops;
+  ostream_iterator& operator*(void) {
+    return *this;
+  }
+  ostream_iterator& operator++(void) {
+    return *this;
+  }
+  ostream_iterator& operator++(int) {
+    return *this;
+  }
+};
+/* end ostream_iterator */
+/* end buffered streams */
+} /* end lem */
+
+#endif /* LEMSTL_LEM_STREAM_ITERATOR_H_ */
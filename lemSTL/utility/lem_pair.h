@@ -0,0 +1,32 @@
+// Pair of two values;
+#ifndef LEMSTL_LEM_PAIR_H_
+#define LEMSTL_LEM_PAIR_H_
+
+namespace lem {
+// See declarations at https://en.cppreference.com/w/cpp/utility/pair;
+template <typename T1, typename T2>
+struct pair {
+  using first_type = T1;
+  using second_type = T2;
+
+  T1 first;
+  T2 second;
+
+  pair(void) : first(), second() {}
+  pair(T1 const& a, T2 const& b) : first(a), second(b) {}
+
+  bool operator==(pair<T1, T2> const& other) const {
+    return first == other.first && second == other.second;
+  }
+  bool operator!=(pair<T1, T2> const& other) const {
+    return !(*this == other);
+  }
+};
+
+template <typename T1, typename T2>
+inline pair<T1, T2> make_pair(T1 const& a, T2 const& b) {
+  return pair<T1, T2>(a, b);
+}
+} /* end lem */
+
+#endif /* LEMSTL_LEM_PAIR_H_ */
@@ -10,12 +10,21 @@
 //  #define TEST_VECTOR_
 //  #define TEST_LIST_
   #define TEST_DEQUE_
+//  #define TEST_HEAP_
+//  #define TEST_SORT_
+//  #define TEST_NUMERIC_
+//  #define TEST_SET_
+//  #define TEST_REMOVE_
+//  #define TEST_RANDOM_
+//  #define TEST_COPY_
+//  #define TEST_STREAM_
 #else
   #include "lemSTL/lem_vector"
   #include "lemSTL/lem_list"
 #endif
 
 #ifdef TEST_VECTOR_
+  #include <thread> // for std::thread;
   #include "lemSTL/lem_vector"
 
   TEST(int_vector_iterator) {
@@ -56,9 +65,10 @@
     vec.push_back(9);
 
     // first push_back test;
+    // the capacity is rounded up to the 8-byte free-list node;
     EXPECT_EQ(vec.empty(), false);
     EXPECT_EQ(vec.size(), 1);
-    EXPECT_EQ(vec.capacity(), 1);
+    EXPECT_EQ(vec.capacity(), 2);
 
     // unrealloc push_back test;
     vec.push_back(7);
@@ -82,14 +92,14 @@
 
     EXPECT_EQ_INT_VECTOR(vec, { 9, 7, 10, 10, 0, 0, 5, 3, 1 });
     EXPECT_EQ(vec.size(), 9);
-    EXPECT_EQ(vec.capacity(), 14);
+    EXPECT_EQ(vec.capacity(), 16);
 
     // pop_back test;
     vec.pop_back();
 
     EXPECT_EQ_INT_VECTOR(vec, { 9, 7, 10, 10, 0, 0, 5, 3 });
     EXPECT_EQ(vec.size(), 8);
-    EXPECT_EQ(vec.capacity(), 14);
+    EXPECT_EQ(vec.capacity(), 16);
   }
   TEST(int_vector_shrink_to_fit) {
     lem::vector<int> vec = { 9, 7, 5, 3 };
@@ -130,29 +140,424 @@
     lem::vector<int> vec = {};
 
     // empty resize test;
+    // 5 ints are rounded up to a 24-byte node;
     vec.resize(5);
 
     EXPECT_EQ_INT_VECTOR(vec, { 0, 0, 0, 0, 0 });
     EXPECT_EQ(vec.size(), 5);
-    EXPECT_EQ(vec.capacity(), 5);
+    EXPECT_EQ(vec.capacity(), 6);
 
     // unrealloc reserve test;
     vec.resize(3);
 
     EXPECT_EQ_INT_VECTOR(vec, { 0, 0, 0 });
     EXPECT_EQ(vec.size(), 3);
-    EXPECT_EQ(vec.capacity(), 5);
+    EXPECT_EQ(vec.capacity(), 6);
 
     // realloc reserve test;
+    // resize() grows by the growth policy as well;
     vec.resize(10);
 
     EXPECT_EQ_INT_VECTOR(vec, { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 });
     EXPECT_EQ(vec.size(), 10);
-    EXPECT_EQ(vec.capacity(), 10);
+    EXPECT_EQ(vec.capacity(), 12);
+  }
+  TEST(int_vector_growth_policy) {
+    // repeated middle insertions reallocate O(log n) times;
+    lem::vector<int> vec = {};
+    int realloc_num = 0;
+    for (int i = 0; i < 1000; ++i) {
+      int* prev_head = vec.begin();
+      int* pos = vec.insert(vec.begin() + vec.size() / 2, i);
+      EXPECT_EQ(*pos, i);
+      realloc_num += (vec.begin() != prev_head ? 1 : 0);
+    }
+    bool logarithmic = (realloc_num <= 11);
+    EXPECT_EQ(logarithmic, true);
+    EXPECT_EQ(vec.capacity(), 1024);
+
+    lem::vector<int, lem::alloc, lem::growth_factor_1_5> golden = {};
+    for (int i = 0; i < 20; ++i) {
+      golden.push_back(i);
+    }
+    EXPECT_EQ(golden.capacity(), 24); // 2, 4, 6, 10, 16, 24 with the size classes;
+    EXPECT_EQ(golden[19], 19);
+
+    lem::vector<double, lem::alloc, lem::growth_exact> exact = {};
+    for (int i = 0; i < 20; ++i) {
+      exact.push_back(i);
+    }
+    EXPECT_EQ(exact.capacity(), 20);
+    exact.resize(30);
+    EXPECT_EQ(exact.capacity(), 30);
+
+    // shrink_to_fit() gives a block of the exact size back;
+    vec.shrink_to_fit();
+    EXPECT_EQ(vec.capacity(), 1000);
+    EXPECT_EQ(vec[0], 1);
+    EXPECT_EQ(vec[500], 998);
+    EXPECT_EQ(vec[999], 0);
+  }
+  TEST(int_vector_copy_and_move) {
+    lem::vector<int> vec = { 0, 1, 2, 3, 4 };
+
+    lem::vector<int> copy(vec);
+    EXPECT_EQ_INT_VECTOR(copy, { 0, 1, 2, 3, 4 });
+    EXPECT_EQ(copy.capacity(), 5);
+    EXPECT_NEQ(copy.begin(), vec.begin());
+
+    // assignment reuses the memory if it fits;
+    int* prev_head = copy.begin();
+    lem::vector<int> short_vec = { 7, 8 };
+    copy = short_vec;
+    EXPECT_EQ_INT_VECTOR(copy, { 7, 8 });
+    EXPECT_EQ(copy.begin(), prev_head);
+    copy = vec;
+    EXPECT_EQ_INT_VECTOR(copy, { 0, 1, 2, 3, 4 });
+    EXPECT_EQ(copy.begin(), prev_head);
+
+    // move takes over the memory;
+    prev_head = vec.begin();
+    lem::vector<int> moved(std::move(vec));
+    EXPECT_EQ(moved.begin(), prev_head);
+    EXPECT_EQ(vec.empty(), true);
+    vec = std::move(moved);
+    EXPECT_EQ(vec.begin(), prev_head);
+    EXPECT_EQ_INT_VECTOR(vec, { 0, 1, 2, 3, 4 });
+
+    copy.push_back(5);
+    vec.swap(copy);
+    EXPECT_EQ_INT_VECTOR(vec, { 0, 1, 2, 3, 4, 5 });
+    EXPECT_EQ_INT_VECTOR(copy, { 0, 1, 2, 3, 4 });
+
+    // elements with their own memory are copied one by one;
+    lem::vector<lem::vector<int>> nested = {};
+    nested.push_back(vec);
+    nested.push_back(copy);
+    lem::vector<lem::vector<int>> nested_copy(nested);
+    nested[0][0] = -1;
+    EXPECT_EQ_INT_VECTOR(nested_copy[0], { 0, 1, 2, 3, 4, 5 });
+    EXPECT_EQ_INT_VECTOR(nested_copy[1], { 0, 1, 2, 3, 4 });
+  }
+  TEST(int_vector_range_insert) {
+    lem::vector<int> vec = { 0, 1, 2 };
+    int arr[] = { 7, 8, 9 };
+
+    // fill insertion is not taken for a range;
+    vec.insert(vec.begin() + 1, 5, 2);
+    EXPECT_EQ_INT_VECTOR(vec, { 0, 5, 5, 1, 2 });
+
+    int* pos = vec.insert(vec.begin() + 1, arr, arr + 3);
+    EXPECT_EQ(*pos, 7);
+    EXPECT_EQ_INT_VECTOR(vec, { 0, 7, 8, 9, 5, 5, 1, 2 });
+    vec.reserve(20);
+    vec.insert(vec.begin() + 6, arr, arr + 3);
+    EXPECT_EQ_INT_VECTOR(vec, { 0, 7, 8, 9, 5, 5, 7, 8, 9, 1, 2 });
+    vec.insert(vec.begin() + 10, arr, arr + 3);
+    EXPECT_EQ_INT_VECTOR(vec, { 0, 7, 8, 9, 5, 5, 7, 8, 9, 1, 7, 8, 9, 2 });
+
+    // a batch is appended with a single reallocation;
+    lem::vector<int> batch(10000, 1);
+    lem::vector<int> dest = { 0 };
+    dest.append(batch.begin(), batch.end());
+    EXPECT_EQ(dest.size(), 10001);
+    EXPECT_EQ(dest.capacity(), 10004); // rounded up to the malloc() granule;
+    EXPECT_EQ(dest[10000], 1);
+
+    vec.assign(arr, arr + 2);
+    EXPECT_EQ_INT_VECTOR(vec, { 7, 8 });
+    EXPECT_EQ(vec.capacity(), 20);
+    vec.assign(batch.begin(), batch.begin() + 30);
+    EXPECT_EQ(vec.size(), 30);
+    EXPECT_EQ(vec.capacity(), 30);
+  }
+  TEST(int_vector_default_init_resize) {
+    lem::vector<int> vec = { 0, 1 };
+
+    vec.resize_for_overwrite(100);
+    EXPECT_EQ(vec.size(), 100);
+    EXPECT_EQ(vec[1], 1);
+    for (int ind = 2; ind < 100; ++ind) {
+      vec[ind] = ind;
+    }
+    EXPECT_EQ(vec[99], 99);
+    vec.resize_default_init(3);
+    EXPECT_EQ_INT_VECTOR(vec, { 0, 1, 2 });
+
+    // the writer may fill less than it is given;
+    size_t written = vec.reserve_and_append(10, [](int* tail, size_t n) {
+      for (size_t ind = 0; ind < n / 2; ++ind) {
+        tail[ind] = 3 + int(ind);
+      }
+      return n / 2;
+    });
+    EXPECT_EQ(written, 5);
+    EXPECT_EQ_INT_VECTOR(vec, { 0, 1, 2, 3, 4, 5, 6, 7 });
+    // but never more;
+    EXPECT_ERROR(vec.reserve_and_append(2, [](int*, size_t n) { return n + 1; }), lem::vector_overflow);
+    EXPECT_EQ(vec.size(), 8);
+
+    // non-trivial types are default constructed;
+    lem::vector<lem::vector<int>> nested = {};
+    nested.resize_default_init(4);
+    EXPECT_EQ(nested.size(), 4);
+    EXPECT_EQ(nested[3].empty(), true);
+  }
+  TEST(bool_vector_bit_packed) {
+    lem::vector<bool> vec(130, false);
+
+    EXPECT_EQ(vec.capacity(), 192); // 3 words;
+    EXPECT_EQ(vec.count(), 0);
+    EXPECT_EQ(vec.find_first(), 130);
+    vec[3] = true;
+    vec[64] = true;
+    vec[129] = true;
+    EXPECT_EQ(vec.count(), 3);
+    EXPECT_EQ(vec.find_first(), 3);
+    EXPECT_EQ(vec.find_next(3), 64);
+    EXPECT_EQ(vec.find_next(64), 129);
+    EXPECT_EQ(vec.find_next(129), 130);
+
+    // proxy references;
+    vec[4] = vec[3];
+    bool value = vec[4];
+    EXPECT_EQ(value, true);
+    lem::swap(vec[4], vec[5]);
+    value = vec[4];
+    EXPECT_EQ(value, false);
+
+    lem::fill(vec.begin() + 10, vec.begin() + 100, true);
+    EXPECT_EQ(vec.count(), 93); // 3, 5, [10, 100) and 129;
+    ptrdiff_t false_num = lem::count(vec.begin(), vec.end(), false);
+    EXPECT_EQ(false_num, 37);
+    ptrdiff_t first_false = lem::find(vec.begin() + 10, vec.end(), false) - vec.begin();
+    EXPECT_EQ(first_false, 100);
+
+    vec.flip();
+    EXPECT_EQ(vec.count(), 37);
+    vec.resize(200, true);
+    EXPECT_EQ(vec.count(), 107);
+    vec.resize(64); // 0, 1, 2, 4, 6, 7, 8, 9 left;
+    vec.push_back(true);
+    EXPECT_EQ(vec.count(), 9);
+    vec.erase(vec.begin(), vec.begin() + 10);
+    EXPECT_EQ(vec.size(), 55);
+    EXPECT_EQ(vec.find_first(), 54);
+    vec.insert(vec.begin(), true, 2);
+    EXPECT_EQ(vec.find_next(1), 56);
+    vec.fill(false);
+    EXPECT_EQ(vec.count(), 0);
+  }
+  TEST(int_small_vector_inline_storage) {
+    lem::small_vector<int, 4> vec = {};
+
+    EXPECT_EQ(vec.is_inline(), true);
+    EXPECT_EQ(vec.capacity(), 4);
+    for (int i = 0; i < 4; ++i) {
+      vec.push_back(i);
+    }
+    EXPECT_EQ_INT_VECTOR(vec, { 0, 1, 2, 3 });
+    EXPECT_EQ(vec.is_inline(), true);
+
+    // spill to the allocator;
+    vec.push_back(vec[0]);
+    EXPECT_EQ_INT_VECTOR(vec, { 0, 1, 2, 3, 0 });
+    EXPECT_EQ(vec.is_inline(), false);
+    EXPECT_EQ(vec.capacity(), 8);
+    int* pos = vec.insert(vec.begin() + 1, 9, 5);
+    EXPECT_EQ(*pos, 9);
+    EXPECT_EQ_INT_VECTOR(vec, { 0, 9, 9, 9, 9, 9, 1, 2, 3, 0 });
+
+    // a copy is inline again if it fits;
+    lem::small_vector<int, 4> copy(vec);
+    EXPECT_EQ(copy.is_inline(), false);
+    copy.erase(copy.begin() + 1, copy.begin() + 7);
+    copy.shrink_to_fit();
+    EXPECT_EQ_INT_VECTOR(copy, { 0, 2, 3, 0 });
+    EXPECT_EQ(copy.is_inline(), true);
+    copy = vec;
+    EXPECT_EQ_INT_VECTOR(copy, { 0, 9, 9, 9, 9, 9, 1, 2, 3, 0 });
+
+    // moving takes over a heap block, and moves inline elements one by one;
+    int* block = copy.begin();
+    lem::small_vector<int, 4> moved(std::move(copy));
+    EXPECT_EQ(moved.begin(), block);
+    EXPECT_EQ(copy.empty(), true);
+    EXPECT_EQ(copy.is_inline(), true);
+    lem::small_vector<int, 4> small = { 7, 8 };
+    moved.swap(small);
+    EXPECT_EQ_INT_VECTOR(moved, { 7, 8 });
+    EXPECT_EQ(moved.is_inline(), true);
+    EXPECT_EQ(small.begin(), block);
+    copy = std::move(moved);
+    EXPECT_EQ_INT_VECTOR(copy, { 7, 8 });
+    EXPECT_EQ(moved.empty(), true);
+
+    vec.resize(2);
+    EXPECT_EQ_INT_VECTOR(vec, { 0, 9 });
+    vec.pop_back();
+    vec.pop_back();
+    EXPECT_EQ(vec.empty(), true);
+    EXPECT_ERROR(vec.pop_back(), lem::pop_empty_vector);
+  }
+  TEST(int_inplace_vector_fixed_capacity) {
+    lem::inplace_vector<int, 4> vec = { 1, 2 };
+
+    EXPECT_EQ(vec.capacity(), 4);
+    vec.insert(vec.begin(), 0);
+    int* pushed = vec.try_push_back(3);
+    EXPECT_EQ(*pushed, 3);
+    EXPECT_EQ_INT_VECTOR(vec, { 0, 1, 2, 3 });
+
+    // full;
+    pushed = vec.try_push_back(4);
+    bool is_null = (pushed == nullptr);
+    EXPECT_EQ(is_null, true);
+    EXPECT_ERROR(vec.push_back(4), lem::vector_overflow);
+    EXPECT_ERROR(vec.resize(5), lem::vector_overflow);
+    EXPECT_EQ_INT_VECTOR(vec, { 0, 1, 2, 3 });
+
+    lem::inplace_vector<int, 4> other = { 9 };
+    other.swap(vec);
+    EXPECT_EQ_INT_VECTOR(vec, { 9 });
+    EXPECT_EQ_INT_VECTOR(other, { 0, 1, 2, 3 });
+    other.erase(other.begin() + 1, other.begin() + 3);
+    vec = other;
+    EXPECT_EQ_INT_VECTOR(vec, { 0, 3 });
+    int arr[] = { 5, 6 };
+    vec.insert(vec.begin() + 1, arr, arr + 2);
+    EXPECT_EQ_INT_VECTOR(vec, { 0, 5, 6, 3 });
+
+    // the writer never gets more than the room left, nor may report more;
+    vec.pop_back();
+    EXPECT_ERROR(vec.reserve_and_append(1, [](int*, size_t n) { return n + 1; }), lem::vector_overflow);
+    EXPECT_EQ(vec.size(), 3);
+
+    // moving leaves the source empty;
+    lem::inplace_vector<int, 4> moved(std::move(vec));
+    EXPECT_EQ_INT_VECTOR(moved, { 0, 5, 6 });
+    EXPECT_EQ(vec.empty(), true);
+    other = std::move(moved);
+    EXPECT_EQ_INT_VECTOR(other, { 0, 5, 6 });
+    EXPECT_EQ(moved.empty(), true);
+  }
+  TEST(soa_vector_columns) {
+    lem::soa_vector<int, double, char> soa;
+
+    for (int ind = 0; ind < 100; ++ind) {
+      soa.push_back(ind, ind * 0.5, char('a' + ind % 26));
+    }
+    EXPECT_EQ(soa.size(), 100);
+    EXPECT_EQ(soa[7].get<0>(), 7);
+    EXPECT_EQ(soa[7].get<1>(), 3.5);
+    EXPECT_EQ(soa[27].get<2>(), 'b');
+
+    // each column is a contiguous and aligned native array;
+    int* ids = soa.column<0>();
+    double* halves = soa.column<1>();
+    bool is_aligned = (size_t(ids) % lem::__kColumnAlign == 0 && size_t(halves) % lem::__kColumnAlign == 0);
+    EXPECT_EQ(is_aligned, true);
+    int sum = 0;
+    for (size_t ind = 0; ind < soa.size(); ++ind) {
+      sum += ids[ind];
+    }
+    EXPECT_EQ(sum, 4950);
+
+    soa[3] = std::make_tuple(-1, -1.0, 'z');
+    std::tuple<int, double, char> row = soa[3];
+    EXPECT_EQ(std::get<0>(row), -1);
+    EXPECT_EQ(std::get<2>(row), 'z');
+
+    lem::soa_vector<int, double, char> copy(soa);
+    soa.pop_back();
+    soa.resize(50);
+    EXPECT_EQ(soa.size(), 50);
+    EXPECT_EQ(copy.size(), 100);
+    EXPECT_EQ(copy.back().get<0>(), 99);
+    copy.shrink_to_fit();
+    EXPECT_EQ(copy.capacity(), 100);
+    EXPECT_EQ(copy[3].get<1>(), -1.0);
+  }
+  TEST(int_stable_vector_no_relocation) {
+    lem::stable_vector<int, lem::alloc, 4> vec = { 0, 1, 2 };
+
+    // chunks of 4, 8, 16, ... elements;
+    int* first = &vec[0];
+    for (int ind = 3; ind < 100; ++ind) {
+      vec.push_back(ind);
+    }
+    EXPECT_EQ(&vec[0], first);
+    EXPECT_EQ(vec.size(), 100);
+    EXPECT_EQ(vec.chunk_count(), 5);
+    EXPECT_EQ(vec[3], 3);
+    EXPECT_EQ(vec[4], 4);
+    EXPECT_EQ(vec[59], 59);
+    EXPECT_EQ(vec[60], 60);
+    EXPECT_EQ(vec.back(), 99);
+
+    EXPECT_EQ(vec.end() - vec.begin(), 100);
+    EXPECT_EQ(*(vec.begin() + 61), 61);
+    EXPECT_EQ(*(vec.end() - 97), 3);
+    int sum = 0;
+    lem::for_each(vec.begin() + 2, vec.end() - 10, [&sum](int value) { sum += value; });
+    EXPECT_EQ(sum, 4004);
+    EXPECT_EQ(lem::count_if(vec.begin(), vec.end(), [](int value) { return value % 2 == 0; }), 50);
+    lem::fill(vec.begin() + 10, vec.begin() + 90, -1);
+    EXPECT_EQ(lem::count(vec.begin(), vec.end(), -1), 80);
+
+    lem::stable_vector<int, lem::alloc, 4> copy(vec);
+    vec.resize(5);
+    vec.shrink_to_fit();
+    EXPECT_EQ(vec.chunk_count(), 2);
+    EXPECT_EQ(&vec[0], first);
+    EXPECT_EQ(copy.size(), 100);
+    EXPECT_EQ(copy[95], 95);
+    EXPECT_ERROR(copy.at(100), std::out_of_range);
+  }
+  TEST(int_concurrent_vector_parallel_append) {
+    lem::concurrent_vector<int> vec;
+    constexpr int kThreadNum = 4;
+    constexpr int kPerThread = 10000;
+
+    std::thread workers[kThreadNum];
+    for (int id = 0; id < kThreadNum; ++id) {
+      workers[id] = std::thread([&vec, id]() {
+        for (int ind = 0; ind < kPerThread; ++ind) {
+          if (ind % 100 == 0) {
+            vec.grow_by(2, id);
+          }
+          else {
+            vec.push_back(id);
+          }
+        }
+      });
+    }
+    for (int id = 0; id < kThreadNum; ++id) {
+      workers[id].join();
+    }
+
+    // each thread appended kPerThread + kPerThread / 100 copies of its id;
+    EXPECT_EQ(vec.size(), 40400);
+    long long sum = 0;
+    bool all_ready = true;
+    for (size_t ind = 0; ind < vec.size(); ++ind) {
+      all_ready = all_ready && vec.ready(ind);
+      sum += vec[ind];
+    }
+    EXPECT_EQ(all_ready, true);
+    EXPECT_EQ(sum, 60600);
+    EXPECT_EQ(vec.ready(vec.size()), false);
+
+    int* first = &vec[0];
+    vec.push_back(7);
+    EXPECT_EQ(&vec[0], first);
+    EXPECT_EQ(vec[40400], 7);
   }
 #endif
 #ifdef TEST_LIST_
   #include "lemSTL/lem_list"
+  #include "lemSTL/lem_algorithm"
+  #include "lemSTL/lem_numeric"
 
   TEST(int_list_ctor) {
     lem::list<int> lst = { 1, 2, 3 };
@@ -338,6 +743,216 @@
     lst.sort();
     EXPECT_EQ_INT_LIST(lst, { -9, -8, -4, -4, 0, 1, 2, 3, 5, 7 });
   }
+  TEST(int_list_copy_and_move) {
+    lem::list<int> lst = { 1, 2, 3 };
+
+    lem::list<int> copy(lst);
+    EXPECT_EQ_INT_LIST(copy, { 1, 2, 3 });
+    copy.push_back(4);
+    EXPECT_EQ_INT_LIST(lst, { 1, 2, 3 });
+
+    copy = lem::list<int>({ 5 });
+    EXPECT_EQ_INT_LIST(copy, { 5 });
+    copy = lst;
+    EXPECT_EQ_INT_LIST(copy, { 1, 2, 3 });
+
+    int* first = &lst.front();
+    lem::list<int> moved(std::move(lst));
+    EXPECT_EQ(&moved.front(), first);
+    EXPECT_EQ(lst.empty(), true);
+    lst = std::move(moved);
+    EXPECT_EQ(&lst.front(), first);
+
+    copy.push_back(4);
+    lst.swap(copy);
+    EXPECT_EQ_INT_LIST(lst, { 1, 2, 3, 4 });
+    EXPECT_EQ_INT_LIST(copy, { 1, 2, 3 });
+  }
+  TEST(int_list_prefetch_traversal) {
+    lem::list<int> lst;
+    for (int ind = 0; ind < 100; ++ind) {
+      lst.push_back(ind % 10);
+    }
+
+    int sum = 0;
+    lst.for_each_prefetch([&sum](int data) { sum += data; });
+    EXPECT_EQ(sum, 450);
+    sum = 0;
+    lst.for_each_prefetch([&sum](int data) { sum += data; }, 1000); // distance beyond the end;
+    EXPECT_EQ(sum, 450);
+
+    EXPECT_EQ(lem::accumulate(lst.begin(), lst.end(), 0, lem::plus<int>()), 450);
+    EXPECT_EQ(lem::count(lst.begin(), lst.end(), 7), 10);
+    EXPECT_EQ(lem::count_if(lst.begin(), lst.end(), [](int data) { return data > 4; }), 50);
+
+    lem::list<int>::iterator iter = lem::find(lst.begin(), lst.end(), 9);
+    EXPECT_EQ(*iter, 9);
+    EXPECT_EQ(*(++iter), 0);
+    bool not_found = (lem::find(lst.begin(), lst.end(), 10) == lst.end());
+    EXPECT_EQ(not_found, true);
+
+    lem::for_each(lst.begin(), lst.end(), [](int& data) { data *= 2; });
+    EXPECT_EQ(lem::accumulate(lst.begin(), lst.end(), 0, lem::plus<int>()), 900);
+  }
+  TEST(int_list_cached_size) {
+    lem::list<int> lst = { 5, 1, 4, 1, 3 };
+    lem::list<int> other = { 0, 2, 2, 6, 7, 8 };
+
+    EXPECT_EQ(lst.size(), 5);
+    lst.insert(lst.begin(), 9);
+    lst.pop_front();
+    lst.remove(4);
+    EXPECT_EQ(lst.size(), 4);
+
+    lem::list<int>::iterator head = other.begin();
+    lem::list<int>::iterator tail = other.begin();
+    lem::advance(tail, 3);
+    lst.splice(lst.end(), other, head, tail);
+    EXPECT_EQ(lst.size(), 7);
+    EXPECT_EQ(other.size(), 3);
+    head = other.begin();
+    tail = other.end();
+    lst.splice(lst.begin(), other, head, --tail, 2);
+    EXPECT_EQ(lst.size(), 9);
+    EXPECT_EQ(other.size(), 1);
+    EXPECT_ERROR(lst.splice(lst.begin(), lst, ++lst.begin(), lst.end(), 8), lem::self_splice);
+    EXPECT_EQ(lst.size(), 9);
+    lst.splice(lst.begin(), other, other.begin());
+    EXPECT_EQ(other.size(), 0);
+    lst.splice(++lst.begin(), lst, --lst.end());
+    EXPECT_EQ(lst.size(), 10);
+
+    lst.sort();
+    EXPECT_EQ_INT_LIST(lst, { 0, 1, 1, 2, 2, 3, 5, 6, 7, 8 });
+    EXPECT_EQ(lst.size(), 10);
+    EXPECT_EQ(lst.unique(), 2);
+    EXPECT_EQ(lst.size(), 8);
+
+    other = { 4, 9 };
+    lst.merge(other);
+    EXPECT_EQ(lst.size(), 10);
+    EXPECT_EQ(other.size(), 0);
+    lst.swap(other);
+    EXPECT_EQ(lst.size(), 0);
+    EXPECT_EQ(other.size(), 10);
+    other.clear();
+    EXPECT_EQ(other.size(), 0);
+  }
+  TEST(list_embedded_header) {
+    struct Big {
+      double data[32];
+    };
+    // the header is 2 links in the object, whatever the element type;
+    EXPECT_EQ(sizeof(lem::list<Big>), 2 * sizeof(void*) + sizeof(size_t));
+
+    lem::list<int> lst = { 1, 2, 3 };
+    lem::list<int> empty;
+    int* first = &lst.front();
+    lem::list<int>::iterator last = --lst.end();
+
+    empty.swap(lst);
+    EXPECT_EQ(lst.empty(), true);
+    bool is_self_linked = (lst.begin() == lst.end());
+    EXPECT_EQ(is_self_linked, true);
+    EXPECT_EQ(&empty.front(), first);
+    EXPECT_EQ(*last, 3);
+    bool is_relinked = (++last == empty.end());
+    EXPECT_EQ(is_relinked, true);
+    EXPECT_EQ_INT_LIST(empty, { 1, 2, 3 });
+
+    lem::list<int> moved(std::move(empty));
+    moved.push_front(0);
+    lst.push_back(4);
+    EXPECT_EQ_INT_LIST(moved, { 0, 1, 2, 3 });
+    EXPECT_EQ_INT_LIST(lst, { 4 });
+    EXPECT_EQ(empty.size(), 0);
+    is_self_linked = (empty.begin() == empty.end());
+    EXPECT_EQ(is_self_linked, true);
+  }
+  TEST(int_unrolled_list_split_and_merge) {
+    using unrolled = lem::unrolled_list<int, 4>;
+    auto as_list = [](unrolled const& ulst) {
+      lem::list<int> lst;
+      for (unrolled::iterator iter = ulst.begin(); iter != ulst.end(); ++iter) {
+        lst.push_back(*iter);
+      }
+      return lst;
+    };
+    lem::list<int> flat;
+
+    unrolled ulst = { 1, 2, 3, 4 };
+    // the node is full, so it is split in halves;
+    unrolled::iterator iter = ulst.begin();
+    lem::advance(iter, 3);
+    iter = ulst.insert(iter, 9);
+    EXPECT_EQ(*iter, 9);
+    EXPECT_EQ(*(--iter), 3);
+    ulst.push_front(0);
+    flat = as_list(ulst);
+    EXPECT_EQ_INT_LIST(flat, { 0, 1, 2, 3, 9, 4 });
+
+    // erasing merges the node with the next one;
+    iter = ulst.erase(ulst.begin());
+    iter = ulst.erase(iter);
+    EXPECT_EQ(*iter, 2);
+    ulst.pop_back();
+    flat = as_list(ulst);
+    EXPECT_EQ_INT_LIST(flat, { 2, 3, 9 });
+
+    unrolled other = { 8, 7, 6, 5, 4, 3 };
+    unrolled::iterator head = other.begin();
+    unrolled::iterator tail = other.begin();
+    lem::advance(head, 1);
+    lem::advance(tail, 4);
+    iter = ulst.begin();
+    ++iter;
+    ulst.splice(iter, other, head, tail);
+    flat = as_list(ulst);
+    EXPECT_EQ_INT_LIST(flat, { 2, 7, 6, 5, 3, 9 });
+    flat = as_list(other);
+    EXPECT_EQ_INT_LIST(flat, { 8, 4, 3 });
+    EXPECT_ERROR(ulst.splice(ulst.begin(), ulst), lem::self_splice);
+
+    ulst.sort();
+    other.sort();
+    ulst.merge(other);
+    flat = as_list(ulst);
+    EXPECT_EQ_INT_LIST(flat, { 2, 3, 3, 4, 5, 6, 7, 8, 9 });
+    EXPECT_EQ(other.size(), 0);
+    EXPECT_EQ(ulst.unique(), 1);
+    EXPECT_EQ(ulst.remove_if([](int data) { return data % 2 == 0; }), 4);
+    ulst.reverse();
+    flat = as_list(ulst);
+    EXPECT_EQ_INT_LIST(flat, { 9, 7, 5, 3 });
+    EXPECT_EQ(lem::count_if(ulst.begin(), ulst.end(), [](int data) { return data > 4; }), 3);
+  }
+  TEST(unrolled_list_stable_sort) {
+    // ordered by key only, as list::sort() and merge() compare by operator>;
+    struct record {
+      int key;
+      int order;
+      bool operator>(record const& other) const {
+        return key > other.key;
+      }
+    };
+    lem::unrolled_list<record, 4> ulst;
+    lem::list<record> lst;
+    for (int i = 0; i < 200; ++i) {
+      ulst.push_back({ (i * 7) % 5, i });
+      lst.push_back({ (i * 7) % 5, i });
+    }
+
+    ulst.sort();
+    lst.sort();
+    int same = 0;
+    lem::list<record>::iterator jter = lst.begin();
+    for (lem::unrolled_list<record, 4>::iterator iter = ulst.begin(); iter != ulst.end(); ++iter, ++jter) {
+      same += (iter->key == jter->key && iter->order == jter->order) ? 1 : 0;
+    }
+    EXPECT_EQ(same, 200);
+    EXPECT_EQ(ulst.front().order, 0);
+    EXPECT_EQ(ulst.back().order, 197);
+  }
 #endif
 #ifdef TEST_DEQUE_
   #include "lemSTL/lem_deque"
@@ -354,6 +969,678 @@
     EXPECT_EQ(dr.at(1), 3);
     EXPECT_EQ(dr.at(2), 3);
   }
+  TEST(int_deque_copy_and_move) {
+    // several buffers of 128 ints;
+    lem::deque<int> dq(300, 0);
+    for (int ind = 0; ind < 300; ++ind) {
+      dq[ind] = ind;
+    }
+
+    lem::deque<int> copy(dq);
+    EXPECT_EQ(copy.size(), 300);
+    bool is_equal = true;
+    for (int ind = 0; ind < 300; ++ind) {
+      is_equal = is_equal && (copy[ind] == ind);
+    }
+    EXPECT_EQ(is_equal, true);
+
+    lem::deque<int> other = { 1, 2 };
+    other = copy;
+    EXPECT_EQ(other.size(), 300);
+    EXPECT_EQ(other[299], 299);
+
+    int* first = &dq[0];
+    lem::deque<int> moved(std::move(dq));
+    EXPECT_EQ(&moved[0], first);
+    EXPECT_EQ(dq.empty(), true);
+    dq = std::move(moved);
+    EXPECT_EQ(&dq[0], first);
+
+    lem::deque<int> small = { 7 };
+    dq.swap(small);
+    EXPECT_EQ(dq.size(), 1);
+    EXPECT_EQ(small.size(), 300);
+    EXPECT_EQ(small[150], 150);
+  }
+#endif
+#ifdef TEST_HEAP_
+  #include "lemSTL/lem_vector"
+  #include "lemSTL/lem_queue"
+
+  TEST(int_heap_binary) {
+    lem::vector<int> vec = { 3, 1, 4, 1, 5, 9, 2, 6, 5, 3 };
+
+    lem::make_heap(vec.begin(), vec.end());
+    EXPECT_EQ(lem::is_heap(vec.begin(), vec.end()), true);
+    EXPECT_EQ(vec.front(), 9);
+
+    vec.push_back(7);
+    lem::push_heap(vec.begin(), vec.end());
+    EXPECT_EQ(lem::is_heap(vec.begin(), vec.end()), true);
+
+    lem::pop_heap(vec.begin(), vec.end());
+    EXPECT_EQ(vec.back(), 9);
+    vec.pop_back();
+    EXPECT_EQ(lem::is_heap(vec.begin(), vec.end()), true);
+
+    lem::sort_heap(vec.begin(), vec.end());
+    EXPECT_EQ_INT_VECTOR(vec, { 1, 1, 2, 3, 3, 4, 5, 5, 6, 7 });
+  }
+  TEST(int_heap_4ary) {
+    lem::vector<int> vec = { 3, 1, 4, 1, 5, 9, 2, 6, 5, 3, 8, 0 };
+
+    lem::make_heap<4>(vec.begin(), vec.end());
+    EXPECT_EQ(lem::is_heap<4>(vec.begin(), vec.end()), true);
+    EXPECT_EQ(vec.front(), 9);
+
+    lem::sort_heap<4>(vec.begin(), vec.end());
+    EXPECT_EQ_INT_VECTOR(vec, { 0, 1, 1, 2, 3, 3, 4, 5, 5, 6, 8, 9 });
+  }
+  TEST(int_priority_queue) {
+    lem::priority_queue<int> pq = { 5, 1, 8 };
+
+    pq.push(3);
+    pq.push(9);
+    EXPECT_EQ(pq.size(), 5);
+    EXPECT_EQ(pq.top(), 9);
+    pq.pop();
+    EXPECT_EQ(pq.top(), 8);
+
+    lem::priority_queue<int, lem::vector<int>, lem::greater<int>, 4> minpq;
+    for (int i = 20; i > 0; --i) {
+      minpq.push(i);
+    }
+    for (int i = 1; i <= 20; ++i) {
+      EXPECT_EQ(minpq.top(), i);
+      minpq.pop();
+    }
+    EXPECT_EQ(minpq.empty(), true);
+    EXPECT_ERROR(minpq.pop(), lem::pop_empty_vector);
+  }
+#endif
+#ifdef TEST_SORT_
+  #include "lemSTL/lem_vector"
+  #include "lemSTL/lem_algorithm"
+
+  TEST(int_vector_sort) {
+    lem::vector<int> vec = { 1, 0, -4, 2, -9, 5, 7, 3, -8, -4 };
+
+    lem::sort(vec.begin(), vec.end());
+    EXPECT_EQ_INT_VECTOR(vec, { -9, -8, -4, -4, 0, 1, 2, 3, 5, 7 });
+
+    lem::vector<int> vec2 = {};
+    for (int i = 0; i < 100; ++i) {
+      vec2.push_back((i * 37) % 100);
+    }
+    lem::sort(vec2.begin(), vec2.end(), lem::greater<int>());
+    for (int i = 0; i < 100; ++i) {
+      EXPECT_EQ(vec2[i], 99 - i);
+    }
+  }
+  TEST(int_vector_radix_sort) {
+    lem::vector<int> vec = {};
+    for (int i = 0; i < 1000; ++i) {
+      vec.push_back((i * 7919) % 1000 - 500);
+    }
+
+    lem::radix_sort(vec);
+    for (int i = 0; i < 1000; ++i) {
+      EXPECT_EQ(vec[i], i - 500);
+    }
+  }
+  TEST(float_vector_radix_sort) {
+    lem::vector<float> vec = {};
+    for (int i = 0; i < 1000; ++i) {
+      vec.push_back(float((i * 7919) % 1000 - 500) / 4);
+    }
+
+    lem::radix_sort(vec);
+    for (int i = 0; i < 1000; ++i) {
+      EXPECT_EQ(vec[i], float(i - 500) / 4);
+    }
+  }
+  TEST(keyed_vector_radix_sort) {
+    struct record {
+      unsigned int id;
+      int order;
+    };
+    lem::vector<record> vec = {};
+    for (int i = 0; i < 1000; ++i) {
+      vec.push_back({ unsigned(i % 10), i });
+    }
+
+    // stable on equal keys;
+    lem::radix_sort(vec, [](record const& r) { return r.id; });
+    for (int i = 0; i < 1000; ++i) {
+      EXPECT_EQ(vec[i].id, unsigned(i / 100));
+      EXPECT_EQ(vec[i].order, (i % 100) * 10 + i / 100);
+    }
+  }
+  TEST(short_keyed_vector_radix_sort) {
+    struct record {
+      int id;
+      int order;
+    };
+    // shorter than __kRadixSortThreshold, still stable on equal keys;
+    lem::vector<record> vec = {};
+    for (int i = 0; i < 60; ++i) {
+      vec.push_back({ 2 - i % 3, i });
+    }
+
+    lem::radix_sort(vec, [](record const& r) { return r.id; });
+    for (int i = 0; i < 60; ++i) {
+      EXPECT_EQ(vec[i].id, i / 20);
+      EXPECT_EQ(vec[i].order, (i % 20) * 3 + 2 - i / 20);
+    }
+  }
+  TEST(char_vector_radix_sort) {
+    // char is signed or not depending on the platform, the order should follow operator<;
+    lem::vector<char> vec = {};
+    for (int i = 0; i < 1000; ++i) {
+      vec.push_back(char((i * 7919) % 256));
+    }
+
+    lem::radix_sort(vec);
+    int unordered = 0;
+    for (int i = 0; i < 999; ++i) {
+      unordered += (vec[i + 1] < vec[i]) ? 1 : 0;
+    }
+    EXPECT_EQ(unordered, 0);
+
+    lem::vector<int> flags = {};
+    for (int i = 0; i < 1000; ++i) {
+      flags.push_back(i);
+    }
+    lem::radix_sort(flags, [](int x) { return x % 3 != 0; });
+    EXPECT_EQ(flags[0], 0);
+    EXPECT_EQ(flags[333], 999);
+    EXPECT_EQ(flags[334], 1);
+  }
+  TEST(int_array_sort_network) {
+    int arr[8] = { 5, -1, 7, 3, 3, 0, 9, -4 };
+    lem::sort_network<8>(arr);
+    for (int i = 0; i < 7; ++i) {
+      bool ordered = (arr[i] <= arr[i + 1]);
+      EXPECT_EQ(ordered, true);
+    }
+    EXPECT_EQ(arr[0], -4);
+    EXPECT_EQ(arr[7], 9);
+
+    // top-3 of 5;
+    lem::vector<double> vec = { 0.5, 2.5, 1.5, 3.5, -0.5 };
+    lem::sort_network<5>(vec.begin(), lem::greater<double>());
+    EXPECT_EQ(vec[0], 3.5);
+    EXPECT_EQ(vec[1], 2.5);
+    EXPECT_EQ(vec[2], 1.5);
+
+    // small ranges of sort() go through the networks;
+    for (int n = 0; n <= 16; ++n) {
+      lem::vector<int> small = {};
+      for (int i = 0; i < n; ++i) {
+        small.push_back((i * 17) % n);
+      }
+      lem::sort(small.begin(), small.end());
+      for (int i = 0; i < n; ++i) {
+        EXPECT_EQ(small[i], i);
+      }
+    }
+  }
+#endif
+#ifdef TEST_NUMERIC_
+  #include "lemSTL/lem_vector"
+  #include "lemSTL/lem_list"
+  #include "lemSTL/lem_numeric"
+
+  TEST(int_vector_reduce) {
+    lem::vector<int> vec = {};
+    for (int i = 1; i <= 100; ++i) {
+      vec.push_back(i);
+    }
+
+    EXPECT_EQ(lem::accumulate(vec.begin(), vec.end(), 0), 5050);
+    EXPECT_EQ(lem::reduce(vec.begin(), vec.end()), 5050);
+    EXPECT_EQ(lem::inner_product(vec.begin(), vec.end(), vec.begin(), 0), 338350);
+
+    lem::list<int> lst = { 1, 2, 3, 4 };
+    EXPECT_EQ(lem::accumulate(lst.begin(), lst.end(), 10), 20);
+    EXPECT_EQ(lem::accumulate(lst.begin(), lst.end(), 1, lem::multiplies<int>()), 24);
+  }
+  TEST(double_vector_reduce) {
+    lem::vector<double> vec = {};
+    for (int i = 1; i <= 100; ++i) {
+      vec.push_back(0.5 * i);
+    }
+
+    EXPECT_EQ(lem::accumulate(vec.begin(), vec.end(), 0.0), 2525.0);
+    EXPECT_EQ(lem::reduce(vec.begin(), vec.end(), 0.0), 2525.0);
+    EXPECT_EQ(lem::transform_reduce(vec.begin(), vec.end(), vec.begin(), 0.0), 84587.5);
+  }
+  TEST(int_vector_partial_sum) {
+    lem::vector<int> vec = { 1, 2, 3, 4, 5 };
+
+    lem::partial_sum(vec.begin(), vec.end(), vec.begin());
+    EXPECT_EQ_INT_VECTOR(vec, { 1, 3, 6, 10, 15 });
+    lem::adjacent_difference(vec.begin(), vec.end(), vec.begin());
+    EXPECT_EQ_INT_VECTOR(vec, { 1, 2, 3, 4, 5 });
+  }
+  TEST(int_vector_minmax_element) {
+    lem::vector<int> vec = {};
+    for (int i = 0; i < 100; ++i) {
+      vec.push_back((i * 37) % 101 - 50);
+    }
+    vec.push_back(50);
+
+    EXPECT_EQ(*lem::min_element(vec.begin(), vec.end()), -50);
+    EXPECT_EQ(lem::max_element(vec.begin(), vec.end()) - vec.begin(), 30);
+    EXPECT_EQ(lem::minmax_element(vec.begin(), vec.end()).second - vec.begin(), 100);
+
+    lem::list<int> lst = { 3, 1, 4, 1, 5 };
+    EXPECT_EQ(*lem::max_element(lst.begin(), lst.end()), 5);
+    EXPECT_EQ(*lem::minmax_element(lst.begin(), lst.end()).first, 1);
+  }
+#endif
+#ifdef TEST_SET_
+  #include "lemSTL/lem_vector"
+  #include "lemSTL/lem_list"
+  #include "lemSTL/lem_algorithm"
+
+  TEST(int_vector_merge) {
+    lem::vector<int> vec1 = { 1, 3, 5, 7 };
+    lem::vector<int> vec2 = { 2, 3, 6 };
+    lem::vector<int> out(7, 0);
+
+    EXPECT_EQ(lem::merge(vec1.begin(), vec1.end(), vec2.begin(), vec2.end(), out.begin()), out.end());
+    EXPECT_EQ_INT_VECTOR(out, { 1, 2, 3, 3, 5, 6, 7 });
+
+    // galloping through the long range;
+    lem::vector<int> longer = {};
+    for (int i = 0; i < 100; ++i) {
+      longer.push_back(2 * i);
+    }
+    lem::vector<int> shorter = { -1, 51, 151, 250 };
+    lem::vector<int> merged(104, 0);
+    lem::merge(longer.begin(), longer.end(), shorter.begin(), shorter.end(), merged.begin());
+    EXPECT_EQ(merged[0], -1);
+    EXPECT_EQ(merged[26], 50);
+    EXPECT_EQ(merged[27], 51);
+    EXPECT_EQ(merged[28], 52);
+    EXPECT_EQ(merged[102], 198);
+    EXPECT_EQ(merged[103], 250);
+
+    lem::vector<int> vec3 = { 1, 4, 7, 2, 3, 5, 6 };
+    lem::inplace_merge(vec3.begin(), vec3.begin() + 3, vec3.end());
+    EXPECT_EQ_INT_VECTOR(vec3, { 1, 2, 3, 4, 5, 6, 7 });
+    lem::inplace_merge(longer.begin(), longer.begin() + 98, longer.end(), lem::less<int>());
+    EXPECT_EQ(longer[99], 198);
+  }
+  TEST(int_vector_set_operations) {
+    lem::vector<int> vec1 = { 1, 2, 2, 4, 6 };
+    lem::vector<int> vec2 = { 2, 3, 4 };
+    lem::vector<int> out(8, 0);
+    int* tail = nullptr;
+
+    tail = lem::set_union(vec1.begin(), vec1.end(), vec2.begin(), vec2.end(), out.begin());
+    EXPECT_EQ(tail - out.begin(), 6);
+    EXPECT_EQ_INT_VECTOR(out, { 1, 2, 2, 3, 4, 6, 0, 0 });
+
+    tail = lem::set_intersection(vec1.begin(), vec1.end(), vec2.begin(), vec2.end(), out.begin());
+    EXPECT_EQ(tail - out.begin(), 2);
+    EXPECT_EQ(out[0], 2);
+    EXPECT_EQ(out[1], 4);
+
+    tail = lem::set_difference(vec1.begin(), vec1.end(), vec2.begin(), vec2.end(), out.begin());
+    EXPECT_EQ(tail - out.begin(), 3);
+    EXPECT_EQ(out[0], 1);
+    EXPECT_EQ(out[1], 2);
+    EXPECT_EQ(out[2], 6);
+
+    EXPECT_EQ(lem::includes(vec1.begin(), vec1.end(), vec2.begin(), vec2.end()), false);
+    EXPECT_EQ(lem::includes(vec1.begin(), vec1.end(), vec1.begin() + 1, vec1.begin() + 3), true);
+
+    // lists go through the linear merge;
+    lem::list<int> lst = { 2, 4 };
+    tail = lem::set_intersection(vec1.begin(), vec1.end(), lst.begin(), lst.end(), out.begin());
+    EXPECT_EQ(tail - out.begin(), 2);
+    EXPECT_EQ(lem::binary_search(vec1.begin(), vec1.end(), 4), true);
+    EXPECT_EQ(lem::binary_search(vec1.begin(), vec1.end(), 5), false);
+  }
+#endif
+#ifdef TEST_REMOVE_
+  #include "lemSTL/lem_vector"
+  #include "lemSTL/lem_list"
+  #include "lemSTL/lem_algorithm"
+
+  TEST(int_vector_remove) {
+    lem::vector<int> vec = {};
+    for (int i = 0; i < 100; ++i) {
+      vec.push_back(i % 3);
+    }
+
+    int* tail = lem::remove(vec.begin(), vec.end(), 1);
+    EXPECT_EQ(tail - vec.begin(), 67);
+    for (int i = 0; i < 67; ++i) {
+      EXPECT_EQ(vec[i], (i % 2) * 2);
+    }
+
+    vec.erase(tail, vec.end());
+    EXPECT_EQ(vec.erase_if([](int x) { return x == 2; }), 33);
+    EXPECT_EQ(vec.size(), 34);
+    EXPECT_EQ(vec[33], 0);
+
+    lem::vector<double> dvec = { 0.5, -1.0, 0.5, 2.0, 0.5, 0.5, 3.0, 0.5, 4.0 };
+    EXPECT_EQ(lem::remove(dvec.begin(), dvec.end(), 0.5) - dvec.begin(), 4);
+    EXPECT_EQ(dvec[3], 4.0);
+
+    // values of another type compare as operator== does, without conversion to the element type;
+    lem::vector<int> mixed = { 2, 3, 2, 5, 2, 2, 7, 2, 2, 9 };
+    EXPECT_EQ(lem::remove(mixed.begin(), mixed.end(), 2.5) - mixed.begin(), 10);
+    mixed.erase(lem::remove(mixed.begin(), mixed.end(), 2.0), mixed.end());
+    EXPECT_EQ_INT_VECTOR(mixed, { 3, 5, 7, 9 });
+  }
+  TEST(int_vector_unique_and_partition) {
+    lem::vector<int> vec = { 1, 1, 2, 2, 2, 3, 1, 1 };
+    int* tail = lem::unique(vec.begin(), vec.end());
+    EXPECT_EQ(tail - vec.begin(), 4);
+    EXPECT_EQ(vec[3], 1);
+
+    lem::vector<int> vec2 = { 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+    int* mid = lem::partition(vec2.begin(), vec2.end(), [](int x) { return x % 2 == 0; });
+    EXPECT_EQ(mid - vec2.begin(), 4);
+    for (int* cur = vec2.begin(); cur != mid; ++cur) {
+      EXPECT_EQ(*cur % 2, 0);
+    }
+
+    lem::vector<int> vec3 = { 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+    lem::stable_partition(vec3.begin(), vec3.end(), [](int x) { return x % 3 == 0; });
+    EXPECT_EQ_INT_VECTOR(vec3, { 3, 6, 9, 1, 2, 4, 5, 7, 8 });
+
+    lem::list<int> lst = { 1, 2, 4, 5, 7, 8, 10 };
+    EXPECT_EQ(lst.unique([](int a, int b) { return b - a == 1; }), 3);
+    EXPECT_EQ_INT_LIST(lst, { 1, 4, 7, 10 });
+    EXPECT_EQ(lst.remove_if([](int x) { return x > 5; }), 2);
+    EXPECT_EQ_INT_LIST(lst, { 1, 4 });
+  }
+#endif
+#ifdef TEST_RANDOM_
+  #include "lemSTL/lem_vector"
+  #include "lemSTL/lem_algorithm"
+  #include "lemSTL/lem_extra"
+
+  TEST(xoshiro_bounded_rand) {
+    lem::xoshiro256pp gen(42);
+    lem::xoshiro256pp gen2(42);
+
+    EXPECT_EQ(gen(), gen2());
+    gen2.jump();
+    EXPECT_NEQ(gen(), gen2());
+
+    int count[6] = { 0, 0, 0, 0, 0, 0 };
+    for (int i = 0; i < 6000; ++i) {
+      int dice = lem::uniform_int(gen, 1, 6);
+      bool in_range = (dice >= 1 && dice <= 6);
+      EXPECT_EQ(in_range, true);
+      if (in_range) {
+        ++count[dice - 1];
+      }
+    }
+    for (int i = 0; i < 6; ++i) {
+      bool balanced = (count[i] > 850 && count[i] < 1150);
+      EXPECT_EQ(balanced, true);
+    }
+
+    double real = lem::uniform_real(gen, -1.0, 1.0);
+    bool in_range = (real >= -1.0 && real < 1.0);
+    EXPECT_EQ(in_range, true);
+  }
+  TEST(int_vector_shuffle_and_sample) {
+    lem::xoshiro256pp gen(7);
+    lem::vector<int> vec = {};
+    for (int i = 0; i < 100; ++i) {
+      vec.push_back(i);
+    }
+
+    lem::shuffle(vec.begin(), vec.end(), gen);
+    int moved = 0;
+    for (int i = 0; i < 100; ++i) {
+      moved += (vec[i] != i);
+    }
+    bool shuffled = (moved > 90);
+    EXPECT_EQ(shuffled, true);
+    lem::sort(vec.begin(), vec.end());
+    for (int i = 0; i < 100; ++i) {
+      EXPECT_EQ(vec[i], i);
+    }
+
+    // chosen elements keep their order;
+    lem::vector<int> out(10, -1);
+    EXPECT_EQ(lem::sample(vec.begin(), vec.end(), out.begin(), 10, gen), out.end());
+    for (int i = 1; i < 10; ++i) {
+      bool ordered = (out[i - 1] < out[i]);
+      EXPECT_EQ(ordered, true);
+    }
+  }
+#endif
+#ifdef TEST_COPY_
+  #include "lemSTL/lem_vector"
+  #include "lemSTL/lem_list"
+  #include "lemSTL/lem_algorithm"
+  #include "lemSTL/lem_numeric"
+
+  TEST(int_vector_bulk_copy) {
+    // tiny, mid-sized and overlapping ranges;
+    int const sizes[] = { 0, 1, 3, 7, 15, 16, 17, 40, 100, 1000 };
+    for (int n : sizes) {
+      lem::vector<int> vec = {};
+      for (int i = 0; i < 2 * n + 8; ++i) {
+        vec.push_back(i);
+      }
+
+      lem::copy(vec.begin() + n + 8, vec.end(), vec.begin());
+      for (int i = 0; i < n; ++i) {
+        EXPECT_EQ(vec[i], n + 8 + i);
+      }
+      lem::copy(vec.begin() + 2, vec.begin() + n + 2, vec.begin());
+      for (int i = 0; i < n; ++i) {
+        int expect = (i + 2 < n ? n + 10 + i : i + 2);
+        EXPECT_EQ(vec[i], expect);
+      }
+
+      lem::vector<int> vec2 = {};
+      for (int i = 0; i <= n; ++i) {
+        vec2.push_back(i);
+      }
+      lem::copy_backward(vec2.begin(), vec2.begin() + n, vec2.end());
+      for (int i = 0; i < n; ++i) {
+        EXPECT_EQ(vec2[i + 1], i);
+      }
+    }
+  }
+  TEST(int_vector_rotate_and_reverse) {
+    lem::vector<int> vec = {};
+    for (int i = 0; i < 300; ++i) {
+      vec.push_back(i);
+    }
+
+    // short shift through the buffer;
+    EXPECT_EQ(lem::rotate(vec.begin(), vec.begin() + 3, vec.end()), vec.begin() + 297);
+    EXPECT_EQ(vec[0], 3);
+    EXPECT_EQ(vec[297], 0);
+    // long shift through block swaps;
+    lem::rotate(vec.begin(), vec.begin() + 150, vec.end());
+    EXPECT_EQ(vec[0], 153);
+    EXPECT_EQ(vec[147], 0);
+    EXPECT_EQ(vec[150], 3);
+
+    lem::reverse(vec.begin(), vec.end());
+    EXPECT_EQ(vec[0], 152);
+    EXPECT_EQ(vec[152], 0);
+    EXPECT_EQ(vec[299], 153);
+
+    lem::swap_ranges(vec.begin(), vec.begin() + 150, vec.begin() + 150);
+    EXPECT_EQ(vec[0], 2);
+    EXPECT_EQ(vec[150], 152);
+
+    lem::list<int> lst = { 1, 2, 3, 4, 5 };
+    lem::rotate(lst.begin(), ++lst.begin(), lst.end());
+    EXPECT_EQ_INT_LIST(lst, { 2, 3, 4, 5, 1 });
+    lem::reverse(lst.begin(), lst.end());
+    EXPECT_EQ_INT_LIST(lst, { 1, 5, 4, 3, 2 });
+  }
+
+  // a pointer wrapper, like a checked or span iterator;
+  template <typename T>
+  struct wrapped_iterator {
+    using iterator_category = lem::contiguous_iterator_tag;
+    using value_type = T;
+    using difference_type = ptrdiff_t;
+    using pointer_type = T*;
+    using reference_type = T&;
+
+    T* ptr_;
+
+    explicit wrapped_iterator(T* ptr) : ptr_(ptr) {}
+    T& operator*(void) const { return *ptr_; }
+    T* operator->(void) const { return ptr_; }
+    wrapped_iterator& operator++(void) { ++ptr_; return *this; }
+    wrapped_iterator& operator--(void) { --ptr_; return *this; }
+    wrapped_iterator operator+(ptrdiff_t n) const { return wrapped_iterator(ptr_ + n); }
+    wrapped_iterator operator-(ptrdiff_t n) const { return wrapped_iterator(ptr_ - n); }
+    ptrdiff_t operator-(wrapped_iterator const& other) const { return ptr_ - other.ptr_; }
+    bool operator==(wrapped_iterator const& other) const { return ptr_ == other.ptr_; }
+    bool operator!=(wrapped_iterator const& other) const { return ptr_ != other.ptr_; }
+  };
+  TEST(int_vector_contiguous_iterator) {
+    lem::vector<int> vec = {};
+    for (int i = 0; i < 100; ++i) {
+      vec.push_back(i);
+    }
+    wrapped_iterator<int> head(vec.begin());
+    wrapped_iterator<int> tail(vec.end());
+
+    EXPECT_EQ(lem::to_address(head), vec.begin());
+    EXPECT_EQ(lem::to_address(vec.begin() + 3), &vec[3]);
+
+    // copy() and copy_backward() take the native pointer path;
+    wrapped_iterator<int> copied = lem::copy(head + 50, tail, head);
+    EXPECT_EQ(copied.ptr_, vec.begin() + 50);
+    EXPECT_EQ(vec[0], 50);
+    EXPECT_EQ(vec[49], 99);
+    lem::copy_backward(head, head + 50, tail);
+    EXPECT_EQ(vec[50], 50);
+    EXPECT_EQ(vec[99], 99);
+
+    lem::fill(head, head + 10, 7);
+    wrapped_iterator<int> filled = lem::fill_n(head + 10, 10, 8);
+    EXPECT_EQ(filled.ptr_, vec.begin() + 20);
+    EXPECT_EQ(vec[9], 7);
+    EXPECT_EQ(vec[19], 8);
+    EXPECT_EQ(vec[20], 70);
+
+    // SIMD kernels;
+    EXPECT_EQ(lem::accumulate(head, head + 20, 0), 150);
+    EXPECT_EQ(lem::reduce(head, head + 20, 0), 150);
+    EXPECT_EQ(lem::inner_product(head, head + 3, head + 10, 0), 168);
+    EXPECT_EQ(*lem::max_element(head, tail), 99);
+    EXPECT_EQ(lem::min_element(head, tail).ptr_, vec.begin());
+    EXPECT_EQ(lem::remove(head, tail, 8).ptr_, vec.end() - 10);
+    EXPECT_EQ(vec[10], 70);
+
+    char text[8] = "abcdefg";
+    lem::fill(wrapped_iterator<char>(text), wrapped_iterator<char>(text + 3), 'x');
+    EXPECT_EQ(text[2], 'x');
+    EXPECT_EQ(text[3], 'd');
+  }
+#endif
+
+#ifdef TEST_STREAM_
+  #include <sstream>
+  #include <cstdint>
+  #include "lemSTL/lem_vector"
+  #include "lemSTL/lem_algorithm"
+  #include "lemSTL/lem_stream"
+
+  TEST(number_parse_and_format) {
+    char const text[] = "-2147483648 2147483648 12abc 0.1 -1.5e3 1e400 +7";
+    char const* tail = text + sizeof(text) - 1;
+
+    int value = 0;
+    char const* cur = lem::parse_number(text, tail, value);
+    EXPECT_EQ(value, -2147483647 - 1);
+    EXPECT_EQ(cur - text, 11);
+    // out of range is an error;
+    bool overflow = (lem::parse_number(cur + 1, tail, value) == cur + 1);
+    EXPECT_EQ(overflow, true);
+    std::int64_t wide = 0;
+    cur = lem::parse_number(cur + 1, tail, wide);
+    EXPECT_EQ(wide, 2147483648ll);
+    // the number stops at the first non-digit;
+    cur = lem::parse_number(cur + 1, tail, value);
+    EXPECT_EQ(value, 12);
+    EXPECT_EQ(*cur, 'a');
+
+    double real = 0;
+    cur = lem::parse_number(cur + 4, tail, real);
+    EXPECT_EQ(real, 0.1);
+    cur = lem::parse_number(cur + 1, tail, real);
+    EXPECT_EQ(real, -1500.0);
+    cur = lem::parse_number(cur + 1, tail, real); // beyond the fast path;
+    bool infinite = (real > 1e308);
+    EXPECT_EQ(infinite, true);
+    float single = 0;
+    cur = lem::parse_number(cur + 1, tail, single);
+    EXPECT_EQ(single, 7.0f);
+    EXPECT_EQ(cur, tail);
+
+    char buffer[64];
+    char* end = lem::format_number(buffer, buffer + 64, -1234567890123ll);
+    EXPECT_EQ(std::string(buffer, end), "-1234567890123");
+    end = lem::format_number(buffer, buffer + 64, 0);
+    EXPECT_EQ(std::string(buffer, end), "0");
+    end = lem::format_number(buffer, buffer + 64, 0.1);
+    real = 0;
+    lem::parse_number(buffer, end, real);
+    EXPECT_EQ(real, 0.1);
+    end = lem::format_number(buffer, buffer + 64, 3.75L);
+    EXPECT_EQ(std::string(buffer, end), "3.75");
+    long double extended = 0;
+    lem::parse_number(buffer, end, extended);
+    EXPECT_EQ(extended, 3.75L);
+    // no room;
+    EXPECT_EQ(lem::format_number(buffer, buffer + 2, 123), buffer);
+  }
+  TEST(int_vector_stream_iterator) {
+    std::stringstream input;
+    for (int i = 0; i < 5000; ++i) {
+      input << (i * 37 - 90000) << (i % 7 == 0 ? "\n" : "  ");
+    }
+
+    // a small buffer, so that tokens cross the refills;
+    lem::buffered_reader reader(input, 64);
+    lem::vector<int> vec = {};
+    lem::copy(lem::istream_iterator<int>(reader), lem::istream_iterator<int>(), lem::back_inserter(vec));
+    EXPECT_EQ(vec.size(), 5000);
+    EXPECT_EQ(vec[0], -90000);
+    EXPECT_EQ(vec[4999], 4999 * 37 - 90000);
+    EXPECT_EQ(reader.eof(), true);
+    EXPECT_EQ(reader.fail(), false);
+
+    std::stringstream output;
+    {
+      lem::buffered_writer writer(output, 64);
+      lem::copy(vec.begin(), vec.begin() + 3, lem::ostream_iterator<int>(writer, " "));
+      char const tag[] = "end";
+      lem::copy(tag, tag + 3, lem::ostreambuf_iterator<char>(writer));
+    }
+    EXPECT_EQ(output.str(), "-90000 -89963 -89926 end");
+
+    // malformed token;
+    std::stringstream broken("1 2 x3 4");
+    lem::buffered_reader broken_reader(broken);
+    lem::vector<int> vec2 = {};
+    lem::copy(lem::istream_iterator<int>(broken_reader), lem::istream_iterator<int>(), lem::back_inserter(vec2));
+    EXPECT_EQ(vec2.size(), 2);
+    EXPECT_EQ(broken_reader.fail(), true);
+  }
 #endif
 
 int main(void) {